@@ -429,7 +429,21 @@ gegl_buffer_iterate_write (GeglBuffer          *buffer,
           tile_base = gegl_tile_get_data (tile);
           tp        = ((guchar *) tile_base) + (offsety * tile_width + offsetx) * px_size;
 
-          if (fish)
+          if (pixels == tile_width && buf_stride == pixels * bpx_size &&
+              lskip == 0 && rskip == 0 &&
+              buffer_y + y >= buffer_abyss_y &&
+              buffer_y + y + MIN (tile_height - offsety, height - y) <= abyss_y_total)
+            {
+              /* full tile rows inside the abyss, contiguous both in the
+               * tile and in buf; convert or copy them in one go */
+              gint rows = MIN (tile_height - offsety, height - y);
+
+              if (fish)
+                babl_process (fish, bp, tp, pixels * rows);
+              else
+                memcpy (tp, bp, pixels * rows * px_size);
+            }
+          else if (fish)
             {
               for (row = offsety;
                    row < tile_height &&
@@ -611,18 +625,32 @@ gegl_buffer_iterate_read_simple (GeglBuffer          *buffer,
           tile_base = gegl_tile_get_data (tile);
           tp        = ((guchar *) tile_base) + (offsety * tile_width + offsetx) * px_size;
 
-          y = bufy;
-          for (row = offsety;
-               row < tile_height && y < height;
-               row++, y++)
+          if (pixels == tile_width && buf_stride == pixels * bpx_size)
             {
+              /* full tile rows, contiguous both in the tile and in buf;
+               * convert or copy them in one go */
+              gint rows = MIN (tile_height - offsety, height - bufy);
+
               if (fish)
-                babl_process (fish, tp, bp, pixels);
+                babl_process (fish, tp, bp, pixels * rows);
               else
-                memcpy (bp, tp, pixels * px_size);
+                memcpy (bp, tp, pixels * rows * px_size);
+            }
+          else
+            {
+              y = bufy;
+              for (row = offsety;
+                   row < tile_height && y < height;
+                   row++, y++)
+                {
+                  if (fish)
+                    babl_process (fish, tp, bp, pixels);
+                  else
+                    memcpy (bp, tp, pixels * px_size);
 
-              tp += tile_stride;
-              bp += buf_stride;
+                  tp += tile_stride;
+                  bp += buf_stride;
+                }
             }
 
           gegl_tile_unref (tile);
@@ -1369,6 +1397,33 @@ _gegl_get_required_for_scale (const Babl          *format,
       }
 }
 
+/* Returns a reference to the tile of @buffer that @rect covers exactly, when
+ * @rect is a whole level 0 tile inside the abyss in the buffer's own format.
+ */
+static GeglTile *
+gegl_buffer_get_tile_for_rect (GeglBuffer          *buffer,
+                               const GeglRectangle *rect,
+                               const Babl          *format)
+{
+  gint tile_width  = buffer->tile_storage->tile_width;
+  gint tile_height = buffer->tile_storage->tile_height;
+  gint tiledx      = rect->x + buffer->shift_x;
+  gint tiledy      = rect->y + buffer->shift_y;
+
+  if (format != buffer->soft_format     ||
+      rect->width  != tile_width        ||
+      rect->height != tile_height       ||
+      gegl_tile_offset (tiledx, tile_width)  != 0 ||
+      gegl_tile_offset (tiledy, tile_height) != 0 ||
+      ! gegl_rectangle_contains (&buffer->abyss, rect))
+    return NULL;
+
+  return gegl_buffer_get_tile (buffer,
+                               gegl_tile_indice (tiledx, tile_width),
+                               gegl_tile_indice (tiledy, tile_height),
+                               0);
+}
+
 static inline void
 _gegl_buffer_get_unlocked (GeglBuffer          *buffer,
                            gdouble              scale,
@@ -1413,6 +1468,21 @@ _gegl_buffer_get_unlocked (GeglBuffer          *buffer,
     }
   if (GEGL_FLOAT_EQUAL (scale, 1.0))
     {
+      gint      tile_stride = buffer->tile_storage->tile_width *
+                              babl_format_get_bytes_per_pixel (format);
+      GeglTile *tile        = NULL;
+
+      if (rowstride == GEGL_AUTO_ROWSTRIDE || rowstride == tile_stride)
+        tile = gegl_buffer_get_tile_for_rect (buffer, rect, format);
+
+      if (tile)
+        {
+          memcpy (dest_buf, gegl_tile_get_data (tile),
+                  tile_stride * rect->height);
+          gegl_tile_unref (tile);
+          return;
+        }
+
       gegl_buffer_iterate_read_dispatch (buffer, rect, dest_buf, rowstride,
                                          format, 0, repeat_mode);
       return;
@@ -1544,6 +1614,462 @@ gegl_buffer_get (GeglBuffer          *buffer,
   gegl_buffer_unlock (buffer);
 }
 
+/* The tiles a batch of gegl_buffer_get_many / gegl_buffer_set_many
+ * rectangles touches, looked up (and for writing locked) only once; the
+ * table spans the tile indices of the bounding box of the batch.
+ */
+typedef struct
+{
+  GeglBuffer  *buffer;
+  gint         index_x;
+  gint         index_y;
+  gint         columns;
+  gint         rows;
+  gboolean     write;
+  GeglTile   **tiles;
+} GeglBufferTileTable;
+
+#define GEGL_BUFFER_TILE_TABLE_MAX 4096
+
+static gboolean
+gegl_buffer_tile_table_init (GeglBufferTileTable *table,
+                             GeglBuffer          *buffer,
+                             const GeglRectangle *bounds,
+                             gboolean             write)
+{
+  gint tile_width  = buffer->tile_storage->tile_width;
+  gint tile_height = buffer->tile_storage->tile_height;
+  gint x0 = gegl_tile_indice (bounds->x + buffer->shift_x, tile_width);
+  gint y0 = gegl_tile_indice (bounds->y + buffer->shift_y, tile_height);
+  gint x1 = gegl_tile_indice (bounds->x + bounds->width - 1 + buffer->shift_x,
+                              tile_width);
+  gint y1 = gegl_tile_indice (bounds->y + bounds->height - 1 + buffer->shift_y,
+                              tile_height);
+
+  table->buffer  = buffer;
+  table->index_x = x0;
+  table->index_y = y0;
+  table->columns = x1 - x0 + 1;
+  table->rows    = y1 - y0 + 1;
+  table->write   = write;
+  table->tiles   = NULL;
+
+  if ((gint64) table->columns * table->rows > GEGL_BUFFER_TILE_TABLE_MAX)
+    return FALSE;
+
+  table->tiles = g_new0 (GeglTile *, table->columns * table->rows);
+  return TRUE;
+}
+
+static inline GeglTile *
+gegl_buffer_tile_table_get (GeglBufferTileTable *table,
+                            gint                 index_x,
+                            gint                 index_y)
+{
+  GeglTile **slot = &table->tiles[(index_y - table->index_y) * table->columns +
+                                  (index_x - table->index_x)];
+
+  if (! *slot)
+    {
+      *slot = gegl_buffer_get_tile (table->buffer, index_x, index_y, 0);
+
+      if (*slot && table->write)
+        gegl_tile_lock (*slot);
+    }
+
+  return *slot;
+}
+
+static void
+gegl_buffer_tile_table_release (GeglBufferTileTable *table)
+{
+  gint i;
+
+  for (i = 0; i < table->columns * table->rows; i++)
+    if (table->tiles[i])
+      {
+        if (table->write)
+          gegl_tile_unlock (table->tiles[i]);
+        gegl_tile_unref (table->tiles[i]);
+      }
+
+  g_free (table->tiles);
+}
+
+/* copies between a level 0 rectangle within the abyss and a linear buffer,
+ * converting with fish if it is non-NULL.
+ */
+static void
+gegl_buffer_tile_table_copy (GeglBufferTileTable *table,
+                             const GeglRectangle *roi,
+                             guchar              *buf,
+                             gint                 buf_stride,
+                             const Babl          *fish,
+                             gint                 px_size,
+                             gint                 bpx_size)
+{
+  GeglBuffer *buffer      = table->buffer;
+  gint        tile_width  = buffer->tile_storage->tile_width;
+  gint        tile_height = buffer->tile_storage->tile_height;
+  gint        tile_stride = px_size * tile_width;
+  gint        buffer_x    = roi->x + buffer->shift_x;
+  gint        buffer_y    = roi->y + buffer->shift_y;
+  gint        bufy        = 0;
+
+  while (bufy < roi->height)
+    {
+      gint tiledy  = buffer_y + bufy;
+      gint offsety = gegl_tile_offset (tiledy, tile_height);
+      gint rows    = MIN (tile_height - offsety, roi->height - bufy);
+      gint bufx    = 0;
+
+      while (bufx < roi->width)
+        {
+          gint      tiledx  = buffer_x + bufx;
+          gint      offsetx = gegl_tile_offset (tiledx, tile_width);
+          gint      pixels  = MIN (tile_width - offsetx, roi->width - bufx);
+          guchar   *bp, *tp;
+          GeglTile *tile;
+          gint      row;
+
+          tile = gegl_buffer_tile_table_get (table,
+                                             gegl_tile_indice (tiledx, tile_width),
+                                             gegl_tile_indice (tiledy, tile_height));
+          if (!tile)
+            {
+              g_warning ("didn't get tile, trying to continue");
+              bufx += pixels;
+              continue;
+            }
+
+          bp = buf + bufy * buf_stride + bufx * bpx_size;
+          tp = gegl_tile_get_data (tile) + (offsety * tile_width + offsetx) * px_size;
+
+          for (row = 0; row < rows; row++)
+            {
+              if (table->write)
+                {
+                  if (fish)
+                    babl_process (fish, bp, tp, pixels);
+                  else
+                    memcpy (tp, bp, pixels * px_size);
+                }
+              else
+                {
+                  if (fish)
+                    babl_process (fish, tp, bp, pixels);
+                  else
+                    memcpy (bp, tp, pixels * px_size);
+                }
+
+              tp += tile_stride;
+              bp += buf_stride;
+            }
+
+          bufx += pixels;
+        }
+      bufy += rows;
+    }
+}
+
+void
+gegl_buffer_get_many (GeglBuffer          *buffer,
+                      const GeglRectangle *rects,
+                      gint                 n_rects,
+                      const Babl          *format,
+                      gpointer            *dest_bufs,
+                      gint                 rowstride,
+                      GeglAbyssPolicy      repeat_mode)
+{
+  GeglBufferTileTable table;
+  GeglRectangle       bounds     = {0, 0, 0, 0};
+  gboolean            has_bounds = FALSE;
+  const Babl         *fish       = NULL;
+  gint                bpx_size;
+  gint                i;
+
+  g_return_if_fail (GEGL_IS_BUFFER (buffer));
+  g_return_if_fail (n_rects == 0 || (rects && dest_bufs));
+
+  if (format == NULL)
+    format = buffer->soft_format;
+  bpx_size = babl_format_get_bytes_per_pixel (format);
+
+  for (i = 0; i < n_rects; i++)
+    {
+      GeglRectangle inside;
+
+      if (gegl_rectangle_intersect (&inside, &rects[i], &buffer->abyss))
+        {
+          if (has_bounds)
+            gegl_rectangle_bounding_box (&bounds, &bounds, &inside);
+          else
+            bounds = inside;
+          has_bounds = TRUE;
+        }
+    }
+
+  gegl_buffer_lock (buffer);
+
+  if (has_bounds && gegl_cl_is_accelerated ())
+    gegl_buffer_cl_cache_flush (buffer, &bounds);
+
+  if (! has_bounds ||
+      ! gegl_buffer_tile_table_init (&table, buffer, &bounds, FALSE))
+    {
+      /* nothing to share between the rectangles */
+      for (i = 0; i < n_rects; i++)
+        _gegl_buffer_get_unlocked (buffer, 1.0, &rects[i], format,
+                                   dest_bufs[i], rowstride, repeat_mode);
+      gegl_buffer_unlock (buffer);
+      return;
+    }
+
+  if (format != buffer->soft_format)
+    fish = babl_fish (buffer->soft_format, format);
+
+  for (i = 0; i < n_rects; i++)
+    {
+      gint stride = rowstride;
+
+      if (gegl_rectangle_is_empty (&rects[i]))
+        continue;
+
+      if (stride == GEGL_AUTO_ROWSTRIDE)
+        stride = rects[i].width * bpx_size;
+
+      if (gegl_rectangle_contains (&buffer->abyss, &rects[i]))
+        gegl_buffer_tile_table_copy (&table, &rects[i], dest_bufs[i], stride,
+                                     fish,
+                                     babl_format_get_bytes_per_pixel (buffer->soft_format),
+                                     bpx_size);
+      else
+        gegl_buffer_iterate_read_dispatch (buffer, &rects[i], dest_bufs[i],
+                                           stride, format, 0, repeat_mode);
+    }
+
+  gegl_buffer_tile_table_release (&table);
+  gegl_buffer_unlock (buffer);
+}
+
+void
+gegl_buffer_set_many (GeglBuffer          *buffer,
+                      const GeglRectangle *rects,
+                      gint                 n_rects,
+                      const Babl          *format,
+                      const gpointer      *src_bufs,
+                      gint                 rowstride)
+{
+  GeglBufferTileTable table;
+  GeglRectangle       bounds     = {0, 0, 0, 0};
+  gboolean            has_bounds = FALSE;
+  const Babl         *fish       = NULL;
+  gint                bpx_size;
+  gint                i;
+
+  g_return_if_fail (GEGL_IS_BUFFER (buffer));
+  g_return_if_fail (n_rects == 0 || (rects && src_bufs));
+
+  if (format == NULL)
+    format = buffer->soft_format;
+  bpx_size = babl_format_get_bytes_per_pixel (format);
+
+  for (i = 0; i < n_rects; i++)
+    {
+      GeglRectangle inside;
+
+      if (gegl_rectangle_intersect (&inside, &rects[i], &buffer->abyss))
+        {
+          if (has_bounds)
+            gegl_rectangle_bounding_box (&bounds, &bounds, &inside);
+          else
+            bounds = inside;
+          has_bounds = TRUE;
+        }
+    }
+
+  if (! has_bounds)
+    return;
+
+  gegl_buffer_lock (buffer);
+
+  if (gegl_cl_is_accelerated ())
+    gegl_buffer_cl_cache_flush (buffer, &bounds);
+
+  if (! gegl_buffer_tile_table_init (&table, buffer, &bounds, TRUE))
+    {
+      /* nothing to share between the rectangles */
+      for (i = 0; i < n_rects; i++)
+        gegl_buffer_iterate_write (buffer, &rects[i], src_bufs[i], rowstride,
+                                   format, 0);
+    }
+  else
+    {
+      if (format != buffer->soft_format)
+        fish = babl_fish (format, buffer->soft_format);
+
+      for (i = 0; i < n_rects; i++)
+        {
+          GeglRectangle  inside;
+          gint           stride = rowstride;
+          guchar        *src;
+
+          /* pixels outside the abyss are not stored */
+          if (! gegl_rectangle_intersect (&inside, &rects[i], &buffer->abyss))
+            continue;
+
+          if (stride == GEGL_AUTO_ROWSTRIDE)
+            stride = rects[i].width * bpx_size;
+
+          src = (guchar *) src_bufs[i] +
+                (inside.y - rects[i].y) * stride +
+                (inside.x - rects[i].x) * bpx_size;
+
+          gegl_buffer_tile_table_copy (&table, &inside, src, stride, fish,
+                                       babl_format_get_bytes_per_pixel (buffer->soft_format),
+                                       bpx_size);
+        }
+
+      gegl_buffer_tile_table_release (&table);
+    }
+
+  if (gegl_buffer_is_shared (buffer))
+    gegl_buffer_flush (buffer);
+
+  gegl_buffer_unlock (buffer);
+
+  gegl_buffer_emit_changed_signal (buffer, &bounds);
+}
+
+typedef struct
+{
+  GeglTile       *tile;
+  GeglRectangle   rect;
+  GeglAccessMode  access;
+} GeglBufferOpenTile;
+
+gpointer
+gegl_buffer_tile_open (GeglBuffer          *buffer,
+                       const GeglRectangle *rect,
+                       const Babl          *format,
+                       GeglAccessMode       access,
+                       gint                *rowstride)
+{
+  GeglBufferOpenTile *open_tile;
+  GeglTile           *tile;
+
+  g_return_val_if_fail (GEGL_IS_BUFFER (buffer), NULL);
+  g_return_val_if_fail (rect != NULL, NULL);
+
+  if (format == NULL)
+    format = buffer->soft_format;
+
+  if (gegl_cl_is_accelerated ())
+    {
+      gegl_buffer_cl_cache_flush (buffer, rect);
+    }
+
+  tile = gegl_buffer_get_tile_for_rect (buffer, rect, format);
+  if (!tile)
+    return NULL;
+
+  /* write access unclones the tile, so the data is only fetched after */
+  if (access & GEGL_ACCESS_WRITE)
+    gegl_tile_lock (tile);
+
+  open_tile         = g_slice_new (GeglBufferOpenTile);
+  open_tile->tile   = tile;
+  open_tile->rect   = *rect;
+  open_tile->access = access;
+
+  g_rec_mutex_lock (&buffer->tile_storage->mutex);
+  buffer->open_tiles = g_slist_prepend (buffer->open_tiles, open_tile);
+  g_rec_mutex_unlock (&buffer->tile_storage->mutex);
+
+  if (rowstride)
+    *rowstride = buffer->tile_storage->tile_width *
+                 babl_format_get_bytes_per_pixel (format);
+
+  return gegl_tile_get_data (tile);
+}
+
+void
+gegl_buffer_tile_close (GeglBuffer *buffer,
+                        gpointer    data)
+{
+  GeglBufferOpenTile *open_tile = NULL;
+  GSList             *iter;
+
+  g_return_if_fail (GEGL_IS_BUFFER (buffer));
+
+  g_rec_mutex_lock (&buffer->tile_storage->mutex);
+  for (iter = buffer->open_tiles; iter; iter = iter->next)
+    {
+      GeglBufferOpenTile *candidate = iter->data;
+
+      if (gegl_tile_get_data (candidate->tile) == data)
+        {
+          open_tile = candidate;
+          buffer->open_tiles = g_slist_delete_link (buffer->open_tiles, iter);
+          break;
+        }
+    }
+  g_rec_mutex_unlock (&buffer->tile_storage->mutex);
+
+  if (!open_tile)
+    {
+      g_warning ("%s: %p is not a tile opened on this buffer", G_STRFUNC, data);
+      return;
+    }
+
+  if (open_tile->access & GEGL_ACCESS_WRITE)
+    {
+      gegl_tile_unlock (open_tile->tile);
+
+      if (gegl_buffer_is_shared (buffer))
+        gegl_buffer_flush (buffer);
+    }
+
+  gegl_tile_unref (open_tile->tile);
+
+  if (open_tile->access & GEGL_ACCESS_WRITE)
+    gegl_buffer_emit_changed_signal (buffer, &open_tile->rect);
+
+  g_slice_free (GeglBufferOpenTile, open_tile);
+}
+
+void
+_gegl_buffer_close_open_tiles (GeglBuffer *buffer)
+{
+  GSList *open_tiles;
+  GSList *iter;
+
+  g_rec_mutex_lock (&buffer->tile_storage->mutex);
+  open_tiles = buffer->open_tiles;
+  buffer->open_tiles = NULL;
+  g_rec_mutex_unlock (&buffer->tile_storage->mutex);
+
+  if (!open_tiles)
+    return;
+
+  g_warning ("%s: %u tiles opened with gegl_buffer_tile_open () on %p "
+             "were never closed", G_STRFUNC, g_slist_length (open_tiles),
+             buffer);
+
+  for (iter = open_tiles; iter; iter = iter->next)
+    {
+      GeglBufferOpenTile *open_tile = iter->data;
+
+      if (open_tile->access & GEGL_ACCESS_WRITE)
+        gegl_tile_unlock (open_tile->tile);
+
+      gegl_tile_unref (open_tile->tile);
+      g_slice_free (GeglBufferOpenTile, open_tile);
+    }
+
+  g_slist_free (open_tiles);
+}
+
 void
 gegl_buffer_sample_cleanup (GeglBuffer *buffer)
 {
@@ -2005,41 +2531,165 @@ gegl_buffer_set_pattern (GeglBuffer          *buffer,
   gegl_free (pattern_data);
 }
 
-void
-gegl_buffer_set_color (GeglBuffer          *dst,
-                       const GeglRectangle *dst_rect,
-                       GeglColor           *color)
+static void
+gegl_buffer_fill_pixel (GeglBuffer          *dst,
+                        const GeglRectangle *rect,
+                        const void          *pixel,
+                        gint                 bpp)
 {
   GeglBufferIterator *i;
-  gchar               pixel[128];
-  gint                bpp;
+
+  if (rect->width <= 0 || rect->height <= 0)
+    return;
+
+  i = gegl_buffer_iterator_new (dst, rect, 0, dst->soft_format,
+                                GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
+  while (gegl_buffer_iterator_next (i))
+    {
+      gegl_memset_pattern (i->data[0], pixel, bpp, i->length);
+    }
+}
+
+void
+gegl_buffer_set_color_from_pixel (GeglBuffer          *dst,
+                                  const GeglRectangle *dst_rect,
+                                  const void          *pixel,
+                                  const Babl          *pixel_format)
+{
+  GeglRectangle  rect;
+  GeglRectangle  cow_rect;
+  gchar          buffer_pixel[128];
+  gint           bpp;
+  gint           tile_width;
+  gint           tile_height;
 
   g_return_if_fail (GEGL_IS_BUFFER (dst));
-  g_return_if_fail (color);
+  g_return_if_fail (pixel);
 
-  gegl_color_get_pixel (color, dst->soft_format, pixel);
+  if (!pixel_format)
+    pixel_format = dst->soft_format;
 
   if (!dst_rect)
     {
       dst_rect = gegl_buffer_get_extent (dst);
     }
-  if (dst_rect->width == 0 ||
-      dst_rect->height == 0)
+
+  gegl_rectangle_intersect (&rect, dst_rect, gegl_buffer_get_abyss (dst));
+
+  if (rect.width <= 0 ||
+      rect.height <= 0)
     return;
 
   bpp = babl_format_get_bytes_per_pixel (dst->soft_format);
 
-  /* FIXME: this can be even further optimized by special casing it so
-   * that fully filled tiles are shared.
-   */
-  i = gegl_buffer_iterator_new (dst, dst_rect, 0, dst->soft_format,
-                                GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-  while (gegl_buffer_iterator_next (i))
+  if (pixel_format != dst->soft_format)
+    babl_process (babl_fish (pixel_format, dst->soft_format),
+                  pixel, buffer_pixel, 1);
+  else
+    memcpy (buffer_pixel, pixel, bpp);
+
+  tile_width  = dst->tile_width;
+  tile_height = dst->tile_height;
+
+  /* the whole tiles covered by the rectangle */
+  cow_rect.x      = gegl_tile_indice (rect.x + dst->shift_x + tile_width - 1,
+                                      tile_width) * tile_width - dst->shift_x;
+  cow_rect.y      = gegl_tile_indice (rect.y + dst->shift_y + tile_height - 1,
+                                      tile_height) * tile_height - dst->shift_y;
+  cow_rect.width  = gegl_tile_indice (rect.x + rect.width + dst->shift_x,
+                                      tile_width) * tile_width - dst->shift_x -
+                    cow_rect.x;
+  cow_rect.height = gegl_tile_indice (rect.y + rect.height + dst->shift_y,
+                                      tile_height) * tile_height - dst->shift_y -
+                    cow_rect.y;
+
+  /* fill one tile and share it, copy on write, with all the others */
+  if (cow_rect.width >= tile_width &&
+      cow_rect.height >= tile_height &&
+      cow_rect.width * cow_rect.height > tile_width * tile_height &&
+      !g_object_get_data (G_OBJECT (dst), "is-linear"))
     {
-      gegl_memset_pattern (i->data[0], pixel, bpp, i->length);
+      GeglTileHandlerCache *cache = dst->tile_storage->cache;
+      GeglRectangle         first = {cow_rect.x, cow_rect.y,
+                                     tile_width, tile_height};
+      GeglRectangle         top, bottom, left, right;
+      GeglTile             *src_tile;
+      gint                  stx, sty;
+      gint                  dst_x, dst_y;
+
+      gegl_buffer_fill_pixel (dst, &first, buffer_pixel, bpp);
+
+      stx = gegl_tile_indice (cow_rect.x + dst->shift_x, tile_width);
+      sty = gegl_tile_indice (cow_rect.y + dst->shift_y, tile_height);
+      src_tile = gegl_buffer_get_tile (dst, stx, sty, 0);
+
+      for (dst_y = cow_rect.y + dst->shift_y; dst_y < cow_rect.y + dst->shift_y + cow_rect.height; dst_y += tile_height)
+      for (dst_x = cow_rect.x + dst->shift_x; dst_x < cow_rect.x + dst->shift_x + cow_rect.width; dst_x += tile_width)
+        {
+          GeglTile *dst_tile;
+          gint      dtx = gegl_tile_indice (dst_x, tile_width);
+          gint      dty = gegl_tile_indice (dst_y, tile_height);
+
+          if (dtx == stx && dty == sty)
+            continue;
+
+          dst_tile = gegl_tile_dup (src_tile);
+          dst_tile->tile_storage = dst->tile_storage;
+          dst_tile->x = dtx;
+          dst_tile->y = dty;
+          dst_tile->z = 0;
+          dst_tile->rev++;
+
+          gegl_tile_handler_cache_insert (cache, dst_tile, dtx, dty, 0);
+
+          gegl_tile_unref (dst_tile);
+        }
+
+      gegl_tile_unref (src_tile);
+
+      gegl_buffer_emit_changed_signal (dst, &cow_rect);
+
+      top = rect;
+      top.height = cow_rect.y - rect.y;
+
+      bottom = rect;
+      bottom.y = cow_rect.y + cow_rect.height;
+      bottom.height = rect.y + rect.height - bottom.y;
+
+      left = cow_rect;
+      left.x = rect.x;
+      left.width = cow_rect.x - rect.x;
+
+      right = cow_rect;
+      right.x = cow_rect.x + cow_rect.width;
+      right.width = rect.x + rect.width - right.x;
+
+      gegl_buffer_fill_pixel (dst, &top, buffer_pixel, bpp);
+      gegl_buffer_fill_pixel (dst, &bottom, buffer_pixel, bpp);
+      gegl_buffer_fill_pixel (dst, &left, buffer_pixel, bpp);
+      gegl_buffer_fill_pixel (dst, &right, buffer_pixel, bpp);
+    }
+  else
+    {
+      gegl_buffer_fill_pixel (dst, &rect, buffer_pixel, bpp);
     }
 }
 
+void
+gegl_buffer_set_color (GeglBuffer          *dst,
+                       const GeglRectangle *dst_rect,
+                       GeglColor           *color)
+{
+  gchar pixel[128];
+
+  g_return_if_fail (GEGL_IS_BUFFER (dst));
+  g_return_if_fail (color);
+
+  gegl_color_get_pixel (color, dst->soft_format, pixel);
+
+  gegl_buffer_set_color_from_pixel (dst, dst_rect, pixel, dst->soft_format);
+}
+
 GeglBuffer *
 gegl_buffer_dup (GeglBuffer *buffer)
 {
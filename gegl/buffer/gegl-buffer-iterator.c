@@ -676,3 +676,221 @@ gegl_buffer_iterator_next (GeglBufferIterator *iter)
       return FALSE;
     }
 }
+
+typedef struct ParallelData
+{
+  const GeglBufferIteratorPriv *template;
+  GeglBufferIteratorFunc        func;
+  gpointer                      state;
+  gpointer                      user_data;
+  gint                          first_y;
+  gint                          band_height;
+  gint                          n_bands;
+  gint                         *next_band;
+  gint                         *pending;
+} ParallelData;
+
+static void
+parallel_process_band (ParallelData *data,
+                       gint          band)
+{
+  const GeglBufferIteratorPriv *template = data->template;
+  const SubIterState           *lead     = &template->sub_iter[0];
+  GeglBufferIterator           *iter     = gegl_buffer_iterator_empty_new ();
+  gint                          y0, y1;
+  gint                          index;
+
+  y0 = MAX (lead->full_rect.y, data->first_y + band * data->band_height);
+  y1 = MIN (lead->full_rect.y + lead->full_rect.height,
+            data->first_y + (band + 1) * data->band_height);
+
+  /* full_rect is stored at the iteration level, gegl_buffer_iterator_add ()
+   * expects 1:1 coordinates.
+   */
+  for (index = 0; index < template->num_buffers; index++)
+    {
+      const SubIterState *sub = &template->sub_iter[index];
+      GeglRectangle       roi;
+
+      roi.x      = sub->full_rect.x << sub->level;
+      roi.y      = (sub->full_rect.y + y0 - lead->full_rect.y) << sub->level;
+      roi.width  = sub->full_rect.width << sub->level;
+      roi.height = (y1 - y0) << sub->level;
+
+      gegl_buffer_iterator_add (iter, sub->buffer, &roi, sub->level,
+                                sub->format,
+                                sub->access_mode & GEGL_ACCESS_READWRITE,
+                                sub->abyss_policy);
+    }
+
+  while (gegl_buffer_iterator_next (iter))
+    data->func (iter, data->state, data->user_data);
+}
+
+static void
+parallel_thread_process (gpointer thread_data,
+                         gpointer unused)
+{
+  ParallelData *data = thread_data;
+  gint          band;
+
+  while ((band = g_atomic_int_add (data->next_band, 1)) < data->n_bands)
+    parallel_process_band (data, band);
+
+  g_atomic_int_add (data->pending, -1);
+}
+
+static gint
+parallel_gcd (gint a,
+              gint b)
+{
+  while (b)
+    {
+      gint t = a % b;
+
+      a = b;
+      b = t;
+    }
+
+  return a;
+}
+
+static GThreadPool *
+parallel_thread_pool (void)
+{
+  static GThreadPool *pool = NULL;
+  if (!pool)
+    {
+      pool = g_thread_pool_new (parallel_thread_process, NULL,
+                                gegl_config_threads (), FALSE, NULL);
+    }
+  return pool;
+}
+
+void
+gegl_buffer_iterator_foreach (GeglBufferIterator          *iter,
+                              GeglBufferIteratorFunc       func,
+                              gpointer                     state,
+                              gsize                        state_size,
+                              GeglBufferIteratorMergeFunc  merge,
+                              gpointer                     user_data)
+{
+  GeglBufferIteratorPriv *priv = iter->priv;
+  const SubIterState     *lead;
+  gint                    lead_shift;
+  gboolean                aligned = TRUE;
+  gint                    threads;
+  gint                    first_row;
+  ParallelData            thread_data[GEGL_MAX_THREADS];
+  gpointer                states = NULL;
+  gint                    next_band = 0;
+  gint                    pending;
+  gint                    i;
+
+  g_return_if_fail (func != NULL);
+  g_return_if_fail (priv->state == GeglIteratorState_Start);
+  g_return_if_fail (priv->num_buffers > 0);
+
+  lead = &priv->sub_iter[0];
+  lead_shift = lead->buffer->shift_y >> lead->level;
+
+  /* Hand out bands that are whole rows of tiles of the lead buffer and of
+   * every buffer written to, so that a tile is never written by two
+   * threads. Such bands exist when the tile rows of those buffers start on
+   * a row of the lead buffer's tiles; their height is the least common
+   * multiple of the tile heights.
+   */
+  thread_data[0].band_height = lead->buffer->tile_height;
+  for (i = 1; i < priv->num_buffers; i++)
+    {
+      const SubIterState *sub = &priv->sub_iter[i];
+      gint                tile_height = sub->buffer->tile_height;
+
+      if (!(sub->access_mode & GEGL_ACCESS_WRITE))
+        continue;
+
+      if ((sub->full_rect.y - lead->full_rect.y +
+           (sub->buffer->shift_y >> sub->level) - lead_shift) % tile_height)
+        aligned = FALSE;
+
+      thread_data[0].band_height =
+        thread_data[0].band_height /
+        parallel_gcd (thread_data[0].band_height, tile_height) * tile_height;
+    }
+
+  first_row = gegl_tile_indice (lead->full_rect.y +
+                                lead_shift,
+                                thread_data[0].band_height);
+  thread_data[0].first_y = first_row * thread_data[0].band_height -
+                           lead_shift;
+  thread_data[0].n_bands =
+    gegl_tile_indice (lead->full_rect.y + lead->full_rect.height - 1 +
+                      lead_shift,
+                      thread_data[0].band_height) - first_row + 1;
+
+  threads = MIN (gegl_config_threads (), thread_data[0].n_bands);
+
+  if (!aligned)
+    threads = MIN (threads, 1);
+
+  if (lead->full_rect.width <= 0 || lead->full_rect.height <= 0)
+    threads = 0;
+
+  if (threads <= 1)
+    {
+      /* Not worth the threads, the reduction runs straight into @state. */
+      if (threads == 1)
+        {
+          while (gegl_buffer_iterator_next (iter))
+            func (iter, state, user_data);
+          return;
+        }
+
+      g_slice_free (GeglBufferIteratorPriv, iter->priv);
+      g_slice_free (GeglBufferIterator, iter);
+      return;
+    }
+
+  /* Every thread starts out from a copy of @state, which thus has to hold
+   * the identity of the reduction.
+   */
+  if (state_size)
+    states = g_malloc (state_size * threads);
+
+  pending = threads;
+
+  for (i = 0; i < threads; i++)
+    {
+      thread_data[i]             = thread_data[0];
+      thread_data[i].template    = priv;
+      thread_data[i].func        = func;
+      thread_data[i].user_data   = user_data;
+      thread_data[i].next_band   = &next_band;
+      thread_data[i].pending     = &pending;
+      thread_data[i].state       = NULL;
+
+      if (states)
+        {
+          thread_data[i].state = (guchar *) states + i * state_size;
+          memcpy (thread_data[i].state, state, state_size);
+        }
+    }
+
+  for (i = 1; i < threads; i++)
+    g_thread_pool_push (parallel_thread_pool (), &thread_data[i], NULL);
+  parallel_thread_process (&thread_data[0], NULL);
+
+  while (g_atomic_int_get (&pending)) {};
+
+  if (states && merge)
+    for (i = 0; i < threads; i++)
+      merge (state, thread_data[i].state, user_data);
+
+  g_free (states);
+
+  /* The template iterator was never started, so there is nothing to
+   * release but itself.
+   */
+  g_slice_free (GeglBufferIteratorPriv, iter->priv);
+  g_slice_free (GeglBufferIterator, iter);
+}
@@ -131,6 +131,61 @@ void                 gegl_buffer_iterator_stop  (GeglBufferIterator *iterator);
  */
 gboolean             gegl_buffer_iterator_next (GeglBufferIterator *iterator);
 
+/**
+ * GeglBufferIteratorFunc:
+ * @iterator: a #GeglBufferIterator positioned on a chunk of data
+ * @state: the reduction state private to the calling thread, or NULL
+ * @user_data: user data passed to gegl_buffer_iterator_foreach()
+ *
+ * Processes the data of one iteration step, as would be done in the body
+ * of a gegl_buffer_iterator_next() loop. Might be called concurrently from
+ * several threads, each with its own @state.
+ */
+typedef void (*GeglBufferIteratorFunc)      (GeglBufferIterator *iterator,
+                                             gpointer            state,
+                                             gpointer            user_data);
+
+/**
+ * GeglBufferIteratorMergeFunc:
+ * @result: the state passed to gegl_buffer_iterator_foreach()
+ * @state: the final reduction state of one of the threads
+ * @user_data: user data passed to gegl_buffer_iterator_foreach()
+ *
+ * Folds the reduction state of one thread into @result.
+ */
+typedef void (*GeglBufferIteratorMergeFunc) (gpointer            result,
+                                             gpointer            state,
+                                             gpointer            user_data);
+
+/**
+ * gegl_buffer_iterator_foreach: (skip)
+ * @iterator: a #GeglBufferIterator that has not been iterated yet
+ * @func: function to call for every iteration step
+ * @state: (allow-none): reduction state, initialized to the identity of the
+ * reduction, the merged result is returned here.
+ * @state_size: the size of @state in bytes
+ * @merge: (allow-none): function merging a per-thread state into @state
+ * @user_data: user data passed to @func and @merge
+ *
+ * Runs @func on all the data covered by @iterator, splitting the work in
+ * rows of tiles that are processed concurrently on the GEGL thread pool.
+ * The rows follow the tiles of the first buffer and of all buffers added
+ * with write access; when the tile rows of a written buffer do not line
+ * up with those of the first buffer, all the work is done on the calling
+ * thread instead. Each thread works on its own copy of @state, the copies are folded back
+ * into @state with @merge once all data has been processed. When only one
+ * thread is used @func operates on @state directly.
+ *
+ * The iterator is consumed and no longer valid after this call. @func is
+ * not allowed to call gegl_buffer_iterator_foreach() itself.
+ */
+void                 gegl_buffer_iterator_foreach (GeglBufferIterator          *iterator,
+                                                   GeglBufferIteratorFunc       func,
+                                                   gpointer                     state,
+                                                   gsize                        state_size,
+                                                   GeglBufferIteratorMergeFunc  merge,
+                                                   gpointer                     user_data);
+
 
 
 #endif
@@ -76,6 +76,8 @@ struct _GeglBuffer
                                                    with no listeners */
 
   GeglTileBackend  *backend;
+
+  GSList           *open_tiles; /* tiles lent out by gegl_buffer_tile_open */
 };
 
 struct _GeglBufferClass
@@ -186,6 +188,11 @@ struct _GeglTile
 
 void _gegl_buffer_drop_hot_tile (GeglBuffer *buffer);
 
+/* releases the tiles left open by gegl_buffer_tile_open (), warning about
+ * them
+ */
+void _gegl_buffer_close_open_tiles (GeglBuffer *buffer);
+
 GeglRectangle _gegl_get_required_for_scale (const Babl          *format,
                                             const GeglRectangle *roi,
                                             gdouble              scale);
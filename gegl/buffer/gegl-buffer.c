@@ -375,6 +375,9 @@ gegl_buffer_dispose (GObject *object)
 
   gegl_buffer_sample_cleanup (buffer);
 
+  /* before the flush below, so that what was written to them is kept */
+  _gegl_buffer_close_open_tiles (buffer);
+
   if (gegl_cl_is_accelerated ())
     gegl_buffer_cl_cache_invalidate (GEGL_BUFFER (object), NULL);
 
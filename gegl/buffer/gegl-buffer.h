@@ -277,6 +277,50 @@ void            gegl_buffer_set               (GeglBuffer          *buffer,
                                                const void          *src,
                                                gint                 rowstride);
 
+/**
+ * gegl_buffer_get_many: (skip)
+ * @buffer: the buffer to retrieve data from.
+ * @rects: the rectangles to fetch, at scale 1.0.
+ * @n_rects: number of rectangles in @rects.
+ * @format: the BablFormat to store in the linear buffers.
+ * @dest_bufs: one linear destination buffer per rectangle.
+ * @rowstride: rowstride in bytes used for all destinations, or
+ * GEGL_AUTO_ROWSTRIDE to use the width of each rectangle.
+ * @repeat_mode: how requests outside the buffer extent are handled.
+ *
+ * Equivalent to calling gegl_buffer_get() for each rectangle, but locking,
+ * tile lookups and format conversion setup are done once for the batch.
+ * Useful for fetching many narrow strips, like the columns of an image.
+ */
+void            gegl_buffer_get_many          (GeglBuffer          *buffer,
+                                               const GeglRectangle *rects,
+                                               gint                 n_rects,
+                                               const Babl          *format,
+                                               gpointer            *dest_bufs,
+                                               gint                 rowstride,
+                                               GeglAbyssPolicy      repeat_mode);
+
+/**
+ * gegl_buffer_set_many: (skip)
+ * @buffer: the buffer to modify.
+ * @rects: the rectangles to store, at level 0.
+ * @n_rects: number of rectangles in @rects.
+ * @format: the babl_format of the linear buffers.
+ * @src_bufs: one linear source buffer per rectangle.
+ * @rowstride: rowstride in bytes used for all sources, or
+ * GEGL_AUTO_ROWSTRIDE to use the width of each rectangle.
+ *
+ * Equivalent to calling gegl_buffer_set() for each rectangle, with the
+ * tiles looked up and locked only once and a single change notification
+ * for the bounding box of the batch.
+ */
+void            gegl_buffer_set_many          (GeglBuffer          *buffer,
+                                               const GeglRectangle *rects,
+                                               gint                 n_rects,
+                                               const Babl          *format,
+                                               const gpointer      *src_bufs,
+                                               gint                 rowstride);
+
 
 /**
  * gegl_buffer_set_color:
@@ -290,6 +334,23 @@ void            gegl_buffer_set_color         (GeglBuffer          *buffer,
                                                const GeglRectangle *rect,
                                                GeglColor           *color);
 
+/**
+ * gegl_buffer_set_color_from_pixel: (skip)
+ * @buffer: a #GeglBuffer
+ * @rect: a rectangular region to fill with a color.
+ * @pixel: pointer to the data of a single pixel
+ * @pixel_format: the babl format of the pixel, or NULL for the format of
+ * the buffer.
+ *
+ * Sets the region covered by rect to the color stored in @pixel. Whole
+ * tiles in the region all end up sharing the memory of a single tile,
+ * until one of them is written to.
+ */
+void            gegl_buffer_set_color_from_pixel (GeglBuffer          *buffer,
+                                                  const GeglRectangle *rect,
+                                                  const void          *pixel,
+                                                  const Babl          *pixel_format);
+
 
 /**
  * gegl_buffer_set_pattern:
@@ -484,6 +545,24 @@ typedef void (*GeglSamplerGetFun)  (GeglSampler     *self,
  */
 GeglSamplerGetFun gegl_sampler_get_fun (GeglSampler *sampler);
 
+typedef void (*GeglSamplerGetSpanFun) (GeglSampler     *self,
+                                       gdouble          x,
+                                       gdouble          y,
+                                       gdouble          dx,
+                                       gdouble          dy,
+                                       GeglMatrix2     *scale,
+                                       void            *output,
+                                       gint             n_samples,
+                                       GeglAbyssPolicy  repeat_mode);
+
+/**
+ * gegl_sampler_get_span_fun: (skip)
+ *
+ * Get the raw span sampler function, like the function returned by
+ * gegl_sampler_get_fun() it does no checks on the passed in coordinates.
+ */
+GeglSamplerGetSpanFun gegl_sampler_get_span_fun (GeglSampler *sampler);
+
 
 /**
  * gegl_buffer_sampler_new: (skip)
@@ -548,6 +627,35 @@ void              gegl_sampler_get            (GeglSampler    *sampler,
                                                void           *output,
                                                GeglAbyssPolicy repeat_mode);
 
+/**
+ * gegl_sampler_get_span:
+ * @sampler: a GeglSampler gotten from gegl_buffer_sampler_new
+ * @x: x coordinate of the first sample
+ * @y: y coordinate of the first sample
+ * @dx: horizontal step between consecutive samples
+ * @dy: vertical step between consecutive samples
+ * @scale: matrix representing extent of sampling area in source buffer,
+ * the same for all samples.
+ * @output: memory location for @n_samples pixels of output data.
+ * @n_samples: the number of samples to take.
+ * @repeat_mode: how requests outside the buffer extent are handled.
+ *
+ * Samples @n_samples points along the line starting at (@x, @y) and
+ * advancing by (@dx, @dy) for every sample, storing the results
+ * consecutively in @output. This gives the same result as calling
+ * gegl_sampler_get() for each of the points, but is considerably cheaper
+ * for filling scanlines of affine transforms.
+ */
+void              gegl_sampler_get_span       (GeglSampler    *sampler,
+                                               gdouble         x,
+                                               gdouble         y,
+                                               gdouble         dx,
+                                               gdouble         dy,
+                                               GeglMatrix2    *scale,
+                                               void           *output,
+                                               gint            n_samples,
+                                               GeglAbyssPolicy repeat_mode);
+
 /* code template utility, updates the jacobian matrix using
  * a user defined mapping function for displacement, example
  * with an identity transform (note that for the identity
@@ -585,6 +693,74 @@ void              gegl_sampler_get            (GeglSampler    *sampler,
  */
 const GeglRectangle * gegl_sampler_get_context_rect (GeglSampler *sampler);
 
+/**
+ * gegl_sampler_prefetch: (skip)
+ * @sampler: a GeglSampler gotten from gegl_buffer_sampler_new
+ * @rect: the pixels the coming sample points fall in
+ * @repeat_mode: how requests outside the buffer extent are handled.
+ *
+ * Lets the sampler fetch the data needed for sampling within @rect in one
+ * go, rather than growing its cache as the samples come in. Useful when
+ * the upcoming sample points are known to stay within a small area, does
+ * nothing if @rect is too large for the sampler's cache.
+ */
+void              gegl_sampler_prefetch       (GeglSampler         *sampler,
+                                               const GeglRectangle *rect,
+                                               GeglAbyssPolicy      repeat_mode);
+
+/**
+ * GeglSamplerCoordsFunc:
+ * @roi: the output pixels to compute source coordinates for
+ * @coords: room for @roi->width * @roi->height pairs of source
+ * coordinates, to be filled in row by row
+ * @scale: (allow-none): when not NULL, room for as many inverse Jacobians
+ * of the mapping, see gegl_sampler_compute_scale
+ * @user_data: the data passed to gegl_buffer_sample_coords
+ *
+ * Computes the source coordinates for a block of output pixels.
+ */
+typedef void (*GeglSamplerCoordsFunc) (const GeglRectangle *roi,
+                                       gdouble             *coords,
+                                       GeglMatrix2         *scale,
+                                       gpointer             user_data);
+
+/**
+ * gegl_buffer_sample_coords: (skip)
+ * @input: the buffer to sample from
+ * @output: the buffer to write to
+ * @roi: the area of @output to fill
+ * @level: mipmap level to process at
+ * @format: the format to sample and write in
+ * @sampler_type: the sampler type to use
+ * @repeat_mode: how requests outside the buffer extent are handled
+ * @with_scale: whether @coords_func computes inverse Jacobians, for the
+ * samplers that make use of them
+ * @copy_exact: whether output pixels whose coordinates are exactly their
+ * own position are copied from @input instead of sampled, which keeps them
+ * sharp with the blurring samplers
+ * @coords_func: computes the source coordinates of output pixels
+ * @user_data: data passed to @coords_func
+ *
+ * Fills @roi of @output by sampling @input at the coordinates computed
+ * by @coords_func, the common inner loop of operations that displace or
+ * warp their input. Coordinates are asked for in blocks of output pixels
+ * at @level and are in the pixel coordinates of @level; non-finite
+ * coordinates yield transparent pixels. The source area of each block
+ * is fetched into the sampler in one go, and blocks that @copy_exact
+ * applies to as a whole are copied from @input without sampling.
+ */
+void              gegl_buffer_sample_coords   (GeglBuffer            *input,
+                                               GeglBuffer            *output,
+                                               const GeglRectangle   *roi,
+                                               gint                   level,
+                                               const Babl            *format,
+                                               GeglSamplerType        sampler_type,
+                                               GeglAbyssPolicy        repeat_mode,
+                                               gboolean               with_scale,
+                                               gboolean               copy_exact,
+                                               GeglSamplerCoordsFunc  coords_func,
+                                               gpointer               user_data);
+
 /**
  * gegl_buffer_linear_new: (skip)
  * @extent: dimensions of buffer.
@@ -655,6 +831,39 @@ gpointer        gegl_buffer_linear_open       (GeglBuffer          *buffer,
 void            gegl_buffer_linear_close      (GeglBuffer    *buffer,
                                                gpointer       linear);
 
+/**
+ * gegl_buffer_tile_open: (skip)
+ * @buffer: a #GeglBuffer.
+ * @rect: the region to access, exactly one tile of @buffer.
+ * @format: desired format or NULL to use buffers format.
+ * @access: whether the returned memory is going to be read, written or both.
+ * @rowstride: return location for rowstride.
+ *
+ * Zero-copy access to the memory of a single tile. The request is only
+ * granted when @rect is aligned to the tile grid, has the size of a tile,
+ * lies within the abyss and @format is the format of the buffer.
+ *
+ * Returns: a pointer to the tile's pixel data that stays valid until
+ * gegl_buffer_tile_close(), or NULL if the request doesn't map to a tile, in
+ * which case gegl_buffer_get() and gegl_buffer_set() should be used instead.
+ */
+gpointer        gegl_buffer_tile_open         (GeglBuffer          *buffer,
+                                               const GeglRectangle *rect,
+                                               const Babl          *format,
+                                               GeglAccessMode       access,
+                                               gint                *rowstride);
+
+/**
+ * gegl_buffer_tile_close:
+ * @buffer: a #GeglBuffer.
+ * @data: the pointer returned by gegl_buffer_tile_open().
+ *
+ * Give back tile memory gotten with gegl_buffer_tile_open(); if it was
+ * opened for writing the buffer is notified of the change.
+ */
+void            gegl_buffer_tile_close        (GeglBuffer          *buffer,
+                                               gpointer             data);
+
 
 /**
  * gegl_buffer_get_abyss:
@@ -24,6 +24,7 @@
 #include "gegl.h"
 #include "gegl-types-internal.h"
 #include "gegl-sampler-cubic.h"
+#include "gegl-config.h"
 
 enum
 {
@@ -35,12 +36,22 @@ enum
 };
 
 static void gegl_sampler_cubic_finalize (      GObject         *gobject);
+static void gegl_sampler_cubic_prepare  (      GeglSampler     *sampler);
 static void gegl_sampler_cubic_get      (      GeglSampler     *sampler,
                                          const gdouble          absolute_x,
                                          const gdouble          absolute_y,
                                                GeglMatrix2     *scale,
                                                void            *output,
                                                GeglAbyssPolicy  repeat_mode);
+static void gegl_sampler_cubic_get_span (      GeglSampler     *sampler,
+                                               gdouble          absolute_x,
+                                               gdouble          absolute_y,
+                                               gdouble          dx,
+                                               gdouble          dy,
+                                               GeglMatrix2     *scale,
+                                               void            *output,
+                                               gint             n_samples,
+                                               GeglAbyssPolicy  repeat_mode);
 static void get_property                (      GObject         *gobject,
                                                guint            prop_id,
                                                GValue          *value,
@@ -66,7 +77,9 @@ gegl_sampler_cubic_class_init (GeglSamplerCubicClass *klass)
   object_class->get_property = get_property;
   object_class->finalize     = gegl_sampler_cubic_finalize;
 
-  sampler_class->get     = gegl_sampler_cubic_get;
+  sampler_class->prepare  = gegl_sampler_cubic_prepare;
+  sampler_class->get      = gegl_sampler_cubic_get;
+  sampler_class->get_span = gegl_sampler_cubic_get_span;
 
   g_object_class_install_property ( object_class, PROP_B,
     g_param_spec_double ("b",
@@ -152,13 +165,61 @@ gegl_sampler_cubic_init (GeglSamplerCubic *self)
     }
 }
 
+/*
+ * With a quality below 1.0 the kernel weights of the four taps are
+ * looked up for the nearest of GEGL_SAMPLER_CUBIC_LUT_PHASES sub-pixel
+ * offsets instead of evaluating the polynomials for every sample. The
+ * table depends on b and c, and is rebuilt when the sampler is prepared.
+ */
+static void
+gegl_sampler_cubic_prepare (GeglSampler *sampler)
+{
+  GeglSamplerCubic *cubic = GEGL_SAMPLER_CUBIC (sampler);
+  gint              phase;
+  gint              i;
+
+  cubic->use_lut = gegl_config ()->quality < 1.0;
+
+  if (!cubic->use_lut)
+    return;
+
+  for (phase = 0; phase <= GEGL_SAMPLER_CUBIC_LUT_PHASES; phase++)
+    {
+      const gfloat x = (gfloat) phase / GEGL_SAMPLER_CUBIC_LUT_PHASES;
+
+      for (i=-1; i<3; i++)
+        cubic->lut[phase][i+1] = cubicKernel (x - i, cubic->b, cubic->c);
+    }
+}
+
 void
-gegl_sampler_cubic_get (      GeglSampler     *self,
-                        const gdouble          absolute_x,
-                        const gdouble          absolute_y,
-                              GeglMatrix2     *scale,
-                              void            *output,
-                              GeglAbyssPolicy  repeat_mode)
+gegl_sampler_cubic_get_weights (GeglSamplerCubic *self,
+                                gfloat            x,
+                                gfloat           *weights)
+{
+  gint i;
+
+  if (self->use_lut)
+    {
+      const gfloat *lut =
+        self->lut[(gint) (x * GEGL_SAMPLER_CUBIC_LUT_PHASES + (gfloat) 0.5)];
+
+      for (i=0; i<4; i++)
+        weights[i] = lut[i];
+    }
+  else
+    {
+      for (i=-1; i<3; i++)
+        weights[i+1] = cubicKernel (x - i, self->b, self->c);
+    }
+}
+
+static inline void
+gegl_sampler_cubic_interpolate (      GeglSampler     *self,
+                                const gdouble          absolute_x,
+                                const gdouble          absolute_y,
+                                      gfloat          *newval,
+                                      GeglAbyssPolicy  repeat_mode)
 {
   GeglSamplerCubic *cubic       = (GeglSamplerCubic*)(self);
   const gint        offsets[16] = {
@@ -169,7 +230,8 @@ gegl_sampler_cubic_get (      GeglSampler     *self,
                                   };
   gfloat           *sampler_bptr;
   gfloat            factor;
-  gfloat            newval[4]   = {0, 0, 0, 0};
+  gfloat            x_kernel[4],
+                    y_kernel[4];
   gint              i,
                     j,
                     k           = 0;
@@ -201,23 +263,82 @@ gegl_sampler_cubic_get (      GeglSampler     *self,
 
   sampler_bptr = gegl_sampler_get_ptr (self, ix, iy, repeat_mode);
 
+  /*
+   * The kernel is separable, evaluate it once per row and column
+   * rather than for each of the 16 taps.
+   */
+  gegl_sampler_cubic_get_weights (cubic, x, x_kernel);
+  gegl_sampler_cubic_get_weights (cubic, y, y_kernel);
+
+  newval[0] = newval[1] = newval[2] = newval[3] = 0;
+
   for (j=-1; j<3; j++)
     for (i=-1; i<3; i++)
       {
         sampler_bptr += offsets[k++];
 
-        factor = cubicKernel (y - j, cubic->b, cubic->c) *
-                 cubicKernel (x - i, cubic->b, cubic->c);
+        factor = y_kernel[j+1] * x_kernel[i+1];
 
         newval[0] += factor * sampler_bptr[0];
         newval[1] += factor * sampler_bptr[1];
         newval[2] += factor * sampler_bptr[2];
         newval[3] += factor * sampler_bptr[3];
       }
+}
+
+void
+gegl_sampler_cubic_get (      GeglSampler     *self,
+                        const gdouble          absolute_x,
+                        const gdouble          absolute_y,
+                              GeglMatrix2     *scale,
+                              void            *output,
+                              GeglAbyssPolicy  repeat_mode)
+{
+  gfloat newval[4];
+
+  gegl_sampler_cubic_interpolate (self, absolute_x, absolute_y, newval,
+                                  repeat_mode);
 
   babl_process (self->fish, newval, output, 1);
 }
 
+static void
+gegl_sampler_cubic_get_span (      GeglSampler     *self,
+                                   gdouble          absolute_x,
+                                   gdouble          absolute_y,
+                                   gdouble          dx,
+                                   gdouble          dy,
+                                   GeglMatrix2     *scale,
+                                   void            *output,
+                                   gint             n_samples,
+                                   GeglAbyssPolicy  repeat_mode)
+{
+  gfloat  chunk[GEGL_SAMPLER_SPAN_CHUNK * 4];
+  gint    bpp    = babl_format_get_bytes_per_pixel (self->format);
+  guchar *out    = output;
+  gint    direct = self->format == self->interpolate_format;
+  gint    done   = 0;
+
+  while (done < n_samples)
+    {
+      gint    count  = MIN (n_samples - done, GEGL_SAMPLER_SPAN_CHUNK);
+      gfloat *newval = direct ? (gfloat *) (out + done * bpp) : chunk;
+      gint    i;
+
+      for (i = 0; i < count; i++)
+        gegl_sampler_cubic_interpolate (self,
+                                        absolute_x + (done + i) * dx,
+                                        absolute_y + (done + i) * dy,
+                                        newval + i * 4,
+                                        repeat_mode);
+
+      if (!direct)
+        babl_process (self->fish, chunk, out + done * bpp, count);
+
+      done += count;
+    }
+}
+
 static void
 get_property (GObject    *object,
               guint       prop_id,
@@ -28,6 +28,12 @@ G_BEGIN_DECLS
 #define GEGL_IS_SAMPLER_CUBIC_CLASS(klass)     (G_TYPE_CHECK_CLASS_TYPE ((klass),  GEGL_TYPE_SAMPLER_CUBIC))
 #define GEGL_SAMPLER_CUBIC_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj),  GEGL_TYPE_SAMPLER_CUBIC, GeglSamplerCubicClass))
 
+/*
+ * Number of sub-pixel phases the kernel weights are tabulated for when
+ * trading quality for speed.
+ */
+#define GEGL_SAMPLER_CUBIC_LUT_PHASES 256
+
 typedef struct _GeglSamplerCubic      GeglSamplerCubic;
 typedef struct _GeglSamplerCubicClass GeglSamplerCubicClass;
 
@@ -39,6 +45,8 @@ struct _GeglSamplerCubic
   gdouble     b;
   gdouble     c;
   gchar      *type;
+  gboolean    use_lut;
+  gfloat      lut[GEGL_SAMPLER_CUBIC_LUT_PHASES + 1][4];
 };
 
 struct _GeglSamplerCubicClass
@@ -48,6 +56,15 @@ struct _GeglSamplerCubicClass
 
 GType gegl_sampler_cubic_get_type (void) G_GNUC_CONST;
 
+/*
+ * Fills weights with the kernel weights of the four taps around a sample
+ * at offset x, in [0,1], from the center of the second tap, as used by
+ * gegl_sampler_get(). For code resampling separably with the same kernel.
+ */
+void  gegl_sampler_cubic_get_weights (GeglSamplerCubic *self,
+                                      gfloat            x,
+                                      gfloat           *weights);
+
 G_END_DECLS
 
 #endif
@@ -37,6 +37,15 @@ static void gegl_sampler_linear_get (      GeglSampler* restrict  self,
                                            GeglMatrix2           *scale,
                                            void*        restrict  output,
                                            GeglAbyssPolicy        repeat_mode);
+static void gegl_sampler_linear_get_span (      GeglSampler* restrict  self,
+                                                gdouble                absolute_x,
+                                                gdouble                absolute_y,
+                                                gdouble                dx,
+                                                gdouble                dy,
+                                                GeglMatrix2           *scale,
+                                                void*        restrict  output,
+                                                gint                   n_samples,
+                                                GeglAbyssPolicy        repeat_mode);
 
 G_DEFINE_TYPE (GeglSamplerLinear, gegl_sampler_linear, GEGL_TYPE_SAMPLER)
 
@@ -45,7 +54,8 @@ gegl_sampler_linear_class_init (GeglSamplerLinearClass *klass)
 {
   GeglSamplerClass *sampler_class = GEGL_SAMPLER_CLASS (klass);
 
-  sampler_class->get = gegl_sampler_linear_get;
+  sampler_class->get      = gegl_sampler_linear_get;
+  sampler_class->get_span = gegl_sampler_linear_get_span;
 }
 
 /*
@@ -73,13 +83,12 @@ gegl_sampler_linear_init (GeglSamplerLinear *self)
   GEGL_SAMPLER (self)->interpolate_format = babl_format ("RaGaBaA float");
 }
 
-static void
-gegl_sampler_linear_get (      GeglSampler*    restrict  self,
-                         const gdouble                   absolute_x,
-                         const gdouble                   absolute_y,
-                               GeglMatrix2              *scale,
-                               void*           restrict  output,
-                               GeglAbyssPolicy           repeat_mode)
+static inline void
+gegl_sampler_linear_interpolate (      GeglSampler*    restrict  self,
+                                 const gdouble                   absolute_x,
+                                 const gdouble                   absolute_y,
+                                       gfloat*         restrict  newval,
+                                       GeglAbyssPolicy           repeat_mode)
 {
   const gint pixels_per_buffer_row = GEGL_SAMPLER_MAXIMUM_WIDTH;
   const gint channels = 4;
@@ -159,8 +168,6 @@ gegl_sampler_linear_get (      GeglSampler*    restrict  self,
    */
   const gfloat w_times_z = (gfloat) 1. - ( x + w_times_y );
 
-  gfloat newval[4];
-
   newval[0] =
     x_times_y * bot_rite_0
     +
@@ -196,7 +203,63 @@ gegl_sampler_linear_get (      GeglSampler*    restrict  self,
     x_times_z * top_rite_3
     +
     w_times_z * top_left_3;
-
-    babl_process (self->fish, newval, output, 1);
   }
 }
+
+static void
+gegl_sampler_linear_get (      GeglSampler*    restrict  self,
+                         const gdouble                   absolute_x,
+                         const gdouble                   absolute_y,
+                               GeglMatrix2              *scale,
+                               void*           restrict  output,
+                               GeglAbyssPolicy           repeat_mode)
+{
+  gfloat newval[4];
+
+  gegl_sampler_linear_interpolate (self, absolute_x, absolute_y, newval,
+                                   repeat_mode);
+
+  babl_process (self->fish, newval, output, 1);
+}
+
+static void
+gegl_sampler_linear_get_span (      GeglSampler*    restrict  self,
+                                    gdouble                   absolute_x,
+                                    gdouble                   absolute_y,
+                                    gdouble                   dx,
+                                    gdouble                   dy,
+                                    GeglMatrix2              *scale,
+                                    void*           restrict  output,
+                                    gint                      n_samples,
+                                    GeglAbyssPolicy           repeat_mode)
+{
+  gfloat  chunk[GEGL_SAMPLER_SPAN_CHUNK * 4];
+  gint    bpp    = babl_format_get_bytes_per_pixel (self->format);
+  guchar *out    = output;
+  gint    direct = self->format == self->interpolate_format;
+  gint    done   = 0;
+
+  /*
+   * Interpolate a chunk at a time and convert it with a single
+   * babl_process call, or interpolate straight into the output when it
+   * already is in the interpolation format.
+   */
+  while (done < n_samples)
+    {
+      gint    count  = MIN (n_samples - done, GEGL_SAMPLER_SPAN_CHUNK);
+      gfloat *newval = direct ? (gfloat *) (out + done * bpp) : chunk;
+      gint    i;
+
+      for (i = 0; i < count; i++)
+        gegl_sampler_linear_interpolate (self,
+                                         absolute_x + (done + i) * dx,
+                                         absolute_y + (done + i) * dy,
+                                         newval + i * 4,
+                                         repeat_mode);
+
+      if (!direct)
+        babl_process (self->fish, chunk, out + done * bpp, count);
+
+      done += count;
+    }
+}
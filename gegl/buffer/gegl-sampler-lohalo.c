@@ -123,6 +123,7 @@
 #include "gegl.h"
 #include "gegl-types-internal.h"
 #include "gegl-sampler-lohalo.h"
+#include "gegl-config.h"
 
 /*
  * Macros set up so the likely winner in in the first argument
@@ -280,6 +281,7 @@
                      channels,              \
                      row_skip,              \
                      input_ptr_##_level_,   \
+                     weight_lut,            \
                      &total_weight,         \
                      ewa_newval)
 
@@ -296,13 +298,41 @@ static void gegl_sampler_lohalo_get (      GeglSampler* restrict  self,
                                            void*        restrict  output,
                                            GeglAbyssPolicy        repeat_mode);
 
+static void gegl_sampler_lohalo_prepare (GeglSampler* restrict self);
+
+static inline gfloat robidoux_radial (const gfloat r2);
+
+/*
+ * The Robidoux EWA weight only depends on the squared distance to the
+ * sampling point, which is below 4 for nonzero weights. When trading
+ * quality for speed the weights are looked up in a table of
+ * LOHALO_WEIGHT_LUT_SIZE steps over [0,4) instead of being computed.
+ */
+#define LOHALO_WEIGHT_LUT_SIZE 2048
+
+static gfloat robidoux_lut[LOHALO_WEIGHT_LUT_SIZE + 1];
+
 G_DEFINE_TYPE (GeglSamplerLohalo, gegl_sampler_lohalo, GEGL_TYPE_SAMPLER)
 
 static void
 gegl_sampler_lohalo_class_init (GeglSamplerLohaloClass *klass)
 {
   GeglSamplerClass *sampler_class = GEGL_SAMPLER_CLASS (klass);
-  sampler_class->get = gegl_sampler_lohalo_get;
+  gint              i;
+
+  sampler_class->get     = gegl_sampler_lohalo_get;
+  sampler_class->prepare = gegl_sampler_lohalo_prepare;
+
+  for (i = 0; i < LOHALO_WEIGHT_LUT_SIZE; i++)
+    robidoux_lut[i] = robidoux_radial ((gfloat) 4. * i / LOHALO_WEIGHT_LUT_SIZE);
+  robidoux_lut[LOHALO_WEIGHT_LUT_SIZE] = (gfloat) 0.;
+}
+
+static void
+gegl_sampler_lohalo_prepare (GeglSampler* restrict self)
+{
+  GEGL_SAMPLER_LOHALO (self)->weight_lut =
+    gegl_config ()->quality < 1.0 ? robidoux_lut : NULL;
 }
 
 /*
@@ -526,12 +556,7 @@ inverse_sigmoidal (const gfloat p)
 }
 
 static inline gfloat
-robidoux (const gfloat c_major_x,
-          const gfloat c_major_y,
-          const gfloat c_minor_x,
-          const gfloat c_minor_y,
-          const gfloat s,
-          const gfloat t)
+robidoux_radial (const gfloat r2)
 {
   /*
    * This function computes -398/(7+72sqrt(2)) times the Robidoux
@@ -558,11 +583,6 @@ robidoux (const gfloat c_major_x,
    * locations when used, as an EWA filter kernel, to resample without
    * downsampling.
    */
-  const gfloat q1 = s * c_major_x + t * c_major_y;
-  const gfloat q2 = s * c_minor_x + t * c_minor_y;
-
-  const gfloat r2 = q1 * q1 + q2 * q2;
-
   if (r2 >= (gfloat) 4.)
     return (gfloat) 0.;
 
@@ -588,6 +608,30 @@ robidoux (const gfloat c_major_x,
   }
 }
 
+static inline gfloat
+robidoux (const gfloat c_major_x,
+          const gfloat c_major_y,
+          const gfloat c_minor_x,
+          const gfloat c_minor_y,
+          const gfloat s,
+          const gfloat t,
+          const gfloat* restrict weight_lut)
+{
+  const gfloat q1 = s * c_major_x + t * c_major_y;
+  const gfloat q2 = s * c_minor_x + t * c_minor_y;
+
+  const gfloat r2 = q1 * q1 + q2 * q2;
+
+  if (r2 >= (gfloat) 4.)
+    return (gfloat) 0.;
+
+  if (weight_lut)
+    return weight_lut[(gint) (r2 * (gfloat) (LOHALO_WEIGHT_LUT_SIZE / 4) +
+                              (gfloat) 0.5)];
+
+  return robidoux_radial (r2);
+}
+
 static inline void
 ewa_update (const gint              j,
             const gint              i,
@@ -600,6 +644,7 @@ ewa_update (const gint              j,
             const gint              channels,
             const gint              row_skip,
             const gfloat*  restrict input_ptr,
+            const gfloat*  restrict weight_lut,
                   gdouble* restrict total_weight,
                   gfloat*  restrict ewa_newval)
 {
@@ -610,7 +655,8 @@ ewa_update (const gint              j,
                                   c_minor_x,
                                   c_minor_y,
                                   x_0 - (gfloat) j,
-                                  y_0 - (gfloat) i);
+                                  y_0 - (gfloat) i,
+                                  weight_lut);
 
   *total_weight += weight;
   ewa_newval[0] += weight * input_ptr[ skip     ];
@@ -632,6 +678,7 @@ mipmap_ewa_update (const gint              level,
                    const gint              channels,
                    const gint              row_skip,
                    const gfloat*  restrict input_ptr,
+                   const gfloat*  restrict weight_lut,
                          gdouble* restrict total_weight,
                          gfloat*  restrict ewa_newval)
 {
@@ -647,7 +694,8 @@ mipmap_ewa_update (const gint              level,
                                   c_minor_x,
                                   c_minor_y,
                                   x - (gfloat) ( (gint) ( 1 << level ) * j),
-                                  y - (gfloat) ( (gint) ( 1 << level ) * i));
+                                  y - (gfloat) ( (gint) ( 1 << level ) * i),
+                                  weight_lut);
 
   const gint skip = j * channels + i * row_skip;
 
@@ -675,6 +723,8 @@ gegl_sampler_lohalo_get (      GeglSampler*    restrict  self,
   const gint pixels_per_row = GEGL_SAMPLER_MAXIMUM_WIDTH;
   const gint row_skip       = channels * pixels_per_row;
 
+  const gfloat* restrict weight_lut = ((GeglSamplerLohalo *) self)->weight_lut;
+
   /*
    * The consequence of the following choice of anchor pixel location
    * is that the sampling location is at most at a box distance of .5
@@ -1294,6 +1344,7 @@ gegl_sampler_lohalo_get (      GeglSampler*    restrict  self,
                           channels,
                           row_skip,
                           input_ptr,
+                          weight_lut,
                           &total_weight,
                           ewa_newval);
             } while ( ++j <= out_rite_0 );
@@ -34,7 +34,10 @@ typedef struct _GeglSamplerLohaloClass GeglSamplerLohaloClass;
 
 struct _GeglSamplerLohalo
 {
-  GeglSampler parent_instance;
+  GeglSampler   parent_instance;
+
+  /*< private >*/
+  const gfloat *weight_lut;
 };
 
 struct _GeglSamplerLohaloClass
@@ -30,6 +30,7 @@
 #include "gegl-buffer.h"
 #include "gegl-buffer-private.h"
 #include "gegl-buffer-cl-cache.h"
+#include "gegl-buffer-iterator.h"
 
 #include "gegl-sampler-nearest.h"
 #include "gegl-sampler-linear.h"
@@ -76,6 +77,16 @@ static void buffer_contents_changed (GeglBuffer          *buffer,
 
 static void constructed (GObject *sampler);
 
+static void get_span                (GeglSampler         *self,
+                                     gdouble              x,
+                                     gdouble              y,
+                                     gdouble              dx,
+                                     gdouble              dy,
+                                     GeglMatrix2         *scale,
+                                     void                *output,
+                                     gint                 n_samples,
+                                     GeglAbyssPolicy      repeat_mode);
+
 static GType gegl_sampler_gtype_from_enum  (GeglSamplerType      sampler_type);
 
 G_DEFINE_TYPE (GeglSampler, gegl_sampler, G_TYPE_OBJECT)
@@ -91,6 +102,7 @@ gegl_sampler_class_init (GeglSamplerClass *klass)
 
   klass->prepare    = NULL;
   klass->get        = NULL;
+  klass->get_span   = get_span;
   klass->set_buffer = set_buffer;
 
   object_class->set_property = set_property;
@@ -147,6 +159,7 @@ constructed (GObject *self)
   GeglSampler *sampler = (void*)(self);
   GeglSamplerClass *klass = GEGL_SAMPLER_GET_CLASS (sampler);
   sampler->get = klass->get;
+  sampler->get_span = klass->get_span;
 }
 
 void
@@ -165,8 +178,26 @@ gegl_sampler_get (GeglSampler     *self,
   if (self->lvel)
   {
     double factor = 1.0 / (1 << self->lvel);
-    GeglRectangle rect={floorf (x * factor), floorf (y * factor),1,1};
-    gegl_buffer_get (self->buffer, &rect, factor, self->format, output, GEGL_AUTO_ROWSTRIDE, repeat_mode);
+
+    /*
+     * Samplers for a mipmap level pick the nearest pixel of that level,
+     * going through the windowed cache of the level like the samplers
+     * themselves do.
+     */
+    if (self->lvel < GEGL_SAMPLER_MIPMAP_LEVELS)
+      {
+        gfloat *pixel = gegl_sampler_get_from_mipmap (self,
+                                                      floor (x * factor),
+                                                      floor (y * factor),
+                                                      self->lvel,
+                                                      repeat_mode);
+        babl_process (self->level_fish, pixel, output, 1);
+      }
+    else
+      {
+        GeglRectangle rect={floorf (x * factor), floorf (y * factor),1,1};
+        gegl_buffer_get (self->buffer, &rect, factor, self->format, output, GEGL_AUTO_ROWSTRIDE, repeat_mode);
+      }
     return;
   }
 
@@ -178,10 +209,74 @@ gegl_sampler_get (GeglSampler     *self,
   self->get (self, x, y, scale, output, repeat_mode);
 }
 
+void
+gegl_sampler_get_span (GeglSampler     *self,
+                       gdouble          x,
+                       gdouble          y,
+                       gdouble          dx,
+                       gdouble          dy,
+                       GeglMatrix2     *scale,
+                       void            *output,
+                       gint             n_samples,
+                       GeglAbyssPolicy  repeat_mode)
+{
+  if (n_samples <= 0)
+    return;
+
+  /* mipmap sampling and non-finite coordinates are dealt with per sample */
+  if (self->lvel ||
+      G_UNLIKELY (!isfinite (x)  || !isfinite (y) ||
+                  !isfinite (dx) || !isfinite (dy)))
+    {
+      gint    bpp = babl_format_get_bytes_per_pixel (self->format);
+      guchar *out = output;
+      gint    i;
+
+      for (i = 0; i < n_samples; i++)
+        gegl_sampler_get (self, x + i * dx, y + i * dy, scale,
+                          out + i * bpp, repeat_mode);
+      return;
+    }
+
+  if (gegl_cl_is_accelerated ())
+    {
+      gdouble x1 = x + (n_samples - 1) * dx;
+      gdouble y1 = y + (n_samples - 1) * dy;
+      GeglRectangle rect = {floor (MIN (x, x1)), floor (MIN (y, y1)), 0, 0};
+
+      rect.width  = ceil (MAX (x, x1)) - rect.x + 1;
+      rect.height = ceil (MAX (y, y1)) - rect.y + 1;
+      gegl_buffer_cl_cache_flush (self->buffer, &rect);
+    }
+  self->get_span (self, x, y, dx, dy, scale, output, n_samples, repeat_mode);
+}
+
+/* Fallback for samplers without a span implementation of their own. */
+static void
+get_span (GeglSampler     *self,
+          gdouble          x,
+          gdouble          y,
+          gdouble          dx,
+          gdouble          dy,
+          GeglMatrix2     *scale,
+          void            *output,
+          gint             n_samples,
+          GeglAbyssPolicy  repeat_mode)
+{
+  gint    bpp = babl_format_get_bytes_per_pixel (self->format);
+  guchar *out = output;
+  gint    i;
+
+  for (i = 0; i < n_samples; i++)
+    self->get (self, x + i * dx, y + i * dy, scale, out + i * bpp,
+               repeat_mode);
+}
+
 void
 gegl_sampler_prepare (GeglSampler *self)
 {
   GeglSamplerClass *klass;
+  gint              i;
 
   g_return_if_fail (GEGL_IS_SAMPLER (self));
 
@@ -199,12 +294,20 @@ gegl_sampler_prepare (GeglSampler *self)
     self->fish = babl_fish (self->interpolate_format, self->format);
 
   /*
-   * This makes the cache rect invalid, in case the data in the buffer
-   * has changed:
+   * The mipmap caches always hold interpolate_format data, while some
+   * samplers set up fish to convert from the buffer format instead.
    */
-  self->level[0].sampler_rectangle.width = 0;
-  self->level[0].sampler_rectangle.height = 0;
+  self->level_fish = babl_fish (self->interpolate_format, self->format);
 
+  /*
+   * This makes the cache rects invalid, in case the data in the buffer
+   * has changed:
+   */
+  for (i = 0; i < GEGL_SAMPLER_MIPMAP_LEVELS; i++)
+    {
+      self->level[i].sampler_rectangle.width = 0;
+      self->level[i].sampler_rectangle.height = 0;
+    }
 }
 
 void
@@ -641,6 +744,45 @@ gegl_sampler_get_context_rect (GeglSampler *sampler)
   return &(sampler->level[0].context_rect);
 }
 
+void
+gegl_sampler_prefetch (GeglSampler         *sampler,
+                       const GeglRectangle *rect,
+                       GeglAbyssPolicy      repeat_mode)
+{
+  GeglSamplerLevel *level = &sampler->level[0];
+  GeglRectangle     fetch_rectangle;
+
+  if (sampler->lvel || !sampler->buffer)
+    return;
+
+  /*
+   * Depending on the sampler the anchor pixel is the one a point falls
+   * in or the one to the left/top of it, allow for either.
+   */
+  fetch_rectangle.x      = rect->x - 1 + level->context_rect.x;
+  fetch_rectangle.y      = rect->y - 1 + level->context_rect.y;
+  fetch_rectangle.width  = rect->width  + 1 + level->context_rect.width;
+  fetch_rectangle.height = rect->height + 1 + level->context_rect.height;
+
+  if (fetch_rectangle.width  > GEGL_SAMPLER_MAXIMUM_WIDTH ||
+      fetch_rectangle.height > GEGL_SAMPLER_MAXIMUM_HEIGHT ||
+      gegl_rectangle_contains (&level->sampler_rectangle, &fetch_rectangle))
+    return;
+
+  if (gegl_cl_is_accelerated ())
+    gegl_buffer_cl_cache_flush (sampler->buffer, &fetch_rectangle);
+
+  level->sampler_rectangle = fetch_rectangle;
+
+  gegl_buffer_get (sampler->buffer,
+                   &level->sampler_rectangle,
+                   1.0,
+                   sampler->interpolate_format,
+                   level->sampler_buffer,
+                   GEGL_SAMPLER_ROWSTRIDE,
+                   repeat_mode);
+}
+
 static void
 buffer_contents_changed (GeglBuffer          *buffer,
                          const GeglRectangle *changed_rect,
@@ -672,3 +814,205 @@ GeglSamplerGetFun gegl_sampler_get_fun (GeglSampler *sampler)
   return sampler->get;
 }
 
+GeglSamplerGetSpanFun gegl_sampler_get_span_fun (GeglSampler *sampler)
+{
+  if (gegl_cl_is_accelerated ())
+    gegl_buffer_cl_cache_flush (sampler->buffer, NULL);
+  return sampler->get_span;
+}
+
+/* Side of the square blocks of output pixels coordinates are asked for. */
+#define GEGL_SAMPLER_COORDS_BLOCK 32
+
+typedef struct
+{
+  GeglBuffer            *input;
+  gint                   level;
+  const Babl            *format;
+  GeglAbyssPolicy        repeat_mode;
+  gboolean               copy_exact;
+  GeglSamplerCoordsFunc  coords_func;
+  gpointer               user_data;
+} SampleCoordsData;
+
+static void
+sample_coords_block (SampleCoordsData    *data,
+                     GeglSampler         *sampler,
+                     GeglSamplerGetFun    sampler_get_fun,
+                     const GeglRectangle *block,
+                     gdouble             *coords,
+                     GeglMatrix2         *scale,
+                     guchar              *copy,
+                     guchar              *dest,
+                     gint                 dest_stride)
+{
+  const gint factor = 1 << data->level;
+  const gint bpp    = babl_format_get_bytes_per_pixel (data->format);
+  gdouble    x_min  = G_MAXDOUBLE;
+  gdouble    y_min  = G_MAXDOUBLE;
+  gdouble    x_max  = -G_MAXDOUBLE;
+  gdouble    y_max  = -G_MAXDOUBLE;
+  gint       n_exact = 0;
+  gint       n;
+  gint       x;
+  gint       y;
+
+  data->coords_func (block, coords, scale, data->user_data);
+
+  n = 0;
+  for (y = 0; y < block->height; y++)
+    for (x = 0; x < block->width; x++, n++)
+      {
+        const gdouble u = coords[n * 2];
+        const gdouble v = coords[n * 2 + 1];
+
+        if (data->copy_exact && u == block->x + x && v == block->y + y)
+          n_exact++;
+        else if (isfinite (u) && isfinite (v))
+          {
+            x_min = MIN (x_min, u);
+            x_max = MAX (x_max, u);
+            y_min = MIN (y_min, v);
+            y_max = MAX (y_max, v);
+          }
+      }
+
+  /* pixels mapping onto themselves are copied, all of them in one go */
+  if (n_exact == block->width * block->height)
+    {
+      gegl_buffer_get (data->input, block, 1.0 / factor, data->format,
+                       dest, dest_stride, data->repeat_mode);
+      return;
+    }
+  else if (n_exact)
+    {
+      gegl_buffer_get (data->input, block, 1.0 / factor, data->format,
+                       copy, block->width * bpp, data->repeat_mode);
+    }
+
+  /* a coherent block is served from a single fetch */
+  if (! data->level && x_min <= x_max &&
+      x_max - x_min < GEGL_SAMPLER_MAXIMUM_WIDTH &&
+      y_max - y_min < GEGL_SAMPLER_MAXIMUM_HEIGHT)
+    {
+      GeglRectangle footprint;
+
+      footprint.x      = floor (x_min);
+      footprint.y      = floor (y_min);
+      footprint.width  = floor (x_max) - footprint.x + 1;
+      footprint.height = floor (y_max) - footprint.y + 1;
+
+      gegl_sampler_prefetch (sampler, &footprint, data->repeat_mode);
+    }
+
+  n = 0;
+  for (y = 0; y < block->height; y++)
+    {
+      guchar *out = dest + y * dest_stride;
+
+      for (x = 0; x < block->width; x++, n++, out += bpp)
+        {
+          const gdouble u = coords[n * 2];
+          const gdouble v = coords[n * 2 + 1];
+
+          if (n_exact && u == block->x + x && v == block->y + y)
+            memcpy (out, copy + n * bpp, bpp);
+          else if (! isfinite (u) || ! isfinite (v))
+            memset (out, 0, bpp);
+          else if (data->level)
+            gegl_sampler_get (sampler, u * factor, v * factor,
+                              scale ? &scale[n] : NULL, out,
+                              data->repeat_mode);
+          else
+            sampler_get_fun (sampler, u, v,
+                             scale ? &scale[n] : NULL, out,
+                             data->repeat_mode);
+        }
+    }
+}
+
+void
+gegl_buffer_sample_coords (GeglBuffer            *input,
+                           GeglBuffer            *output,
+                           const GeglRectangle   *roi,
+                           gint                   level,
+                           const Babl            *format,
+                           GeglSamplerType        sampler_type,
+                           GeglAbyssPolicy        repeat_mode,
+                           gboolean               with_scale,
+                           gboolean               copy_exact,
+                           GeglSamplerCoordsFunc  coords_func,
+                           gpointer               user_data)
+{
+  SampleCoordsData    data;
+  GeglSampler        *sampler;
+  GeglSamplerGetFun   sampler_get_fun;
+  GeglBufferIterator *i;
+  gdouble            *coords;
+  GeglMatrix2        *scale = NULL;
+  guchar             *copy  = NULL;
+  gint                bpp;
+
+  g_return_if_fail (GEGL_IS_BUFFER (input));
+  g_return_if_fail (GEGL_IS_BUFFER (output));
+  g_return_if_fail (roi != NULL);
+  g_return_if_fail (coords_func != NULL);
+
+  if (format == NULL)
+    format = babl_format ("RaGaBaA float");
+
+  bpp = babl_format_get_bytes_per_pixel (format);
+
+  data.input       = input;
+  data.level       = level;
+  data.format      = format;
+  data.repeat_mode = repeat_mode;
+  data.copy_exact  = copy_exact;
+  data.coords_func = coords_func;
+  data.user_data   = user_data;
+
+  sampler = gegl_buffer_sampler_new_at_level (input, format, sampler_type,
+                                              level);
+  sampler_get_fun = gegl_sampler_get_fun (sampler);
+
+  coords = g_new (gdouble, 2 * GEGL_SAMPLER_COORDS_BLOCK *
+                               GEGL_SAMPLER_COORDS_BLOCK);
+  if (with_scale)
+    scale = g_new (GeglMatrix2, GEGL_SAMPLER_COORDS_BLOCK *
+                                GEGL_SAMPLER_COORDS_BLOCK);
+  if (copy_exact)
+    copy = g_malloc (bpp * GEGL_SAMPLER_COORDS_BLOCK *
+                           GEGL_SAMPLER_COORDS_BLOCK);
+
+  i = gegl_buffer_iterator_new (output, roi, level, format,
+                                GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
+
+  while (gegl_buffer_iterator_next (i))
+    {
+      GeglRectangle *iroi = &i->roi[0];
+      gint           block_x;
+      gint           block_y;
+
+      for (block_y = 0; block_y < iroi->height; block_y += GEGL_SAMPLER_COORDS_BLOCK)
+        for (block_x = 0; block_x < iroi->width; block_x += GEGL_SAMPLER_COORDS_BLOCK)
+          {
+            GeglRectangle block;
+
+            block.x      = iroi->x + block_x;
+            block.y      = iroi->y + block_y;
+            block.width  = MIN (GEGL_SAMPLER_COORDS_BLOCK, iroi->width  - block_x);
+            block.height = MIN (GEGL_SAMPLER_COORDS_BLOCK, iroi->height - block_y);
+
+            sample_coords_block (&data, sampler, sampler_get_fun, &block,
+                                 coords, scale, copy,
+                                 (guchar *) i->data[0] +
+                                 (block_y * iroi->width + block_x) * bpp,
+                                 iroi->width * bpp);
+          }
+    }
+
+  g_free (coords);
+  g_free (scale);
+  g_free (copy);
+  g_object_unref (sampler);
+}
@@ -44,6 +44,11 @@ G_BEGIN_DECLS
 #define GEGL_SAMPLER_MAXIMUM_WIDTH (GEGL_SAMPLER_MAXIMUM_HEIGHT)
 #define GEGL_SAMPLER_BPP 16
 #define GEGL_SAMPLER_ROWSTRIDE (GEGL_SAMPLER_MAXIMUM_WIDTH * GEGL_SAMPLER_BPP)
+/*
+ * Number of samples span samplers interpolate before handing them to
+ * babl in one go.
+ */
+#define GEGL_SAMPLER_SPAN_CHUNK 64
 
 typedef struct _GeglSamplerClass GeglSamplerClass;
 
@@ -63,8 +68,9 @@ typedef struct GeglSamplerLevel
 
 struct _GeglSampler
 {
-  GObject           parent_instance;
-  GeglSamplerGetFun get;
+  GObject               parent_instance;
+  GeglSamplerGetFun     get;
+  GeglSamplerGetSpanFun get_span;
 
   /*< private >*/
   GeglBuffer    *buffer;
@@ -72,6 +78,7 @@ struct _GeglSampler
   const Babl    *format;
   const Babl    *interpolate_format;
   const Babl    *fish;
+  const Babl    *level_fish;
 
   GeglSamplerLevel level[GEGL_SAMPLER_MIPMAP_LEVELS];
 };
@@ -84,6 +91,7 @@ struct _GeglSamplerClass
   GeglSamplerGetFun   get;
   void  (*set_buffer) (GeglSampler     *self,
                        GeglBuffer      *buffer);
+  GeglSamplerGetSpanFun get_span;
 };
 
 GType gegl_sampler_get_type    (void) G_GNUC_CONST;
@@ -115,11 +115,27 @@ enum
 
 enum
 {
-  ARCH_X86_INTEL_FEATURE_PNI      = 1 << 0
+  ARCH_X86_INTEL_FEATURE_PNI      = 1 << 0,
+  ARCH_X86_INTEL_FEATURE_SSE4_1   = 1 << 19,
+  ARCH_X86_INTEL_FEATURE_OSXSAVE  = 1 << 27,
+  ARCH_X86_INTEL_FEATURE_AVX      = 1 << 28
+};
+
+enum
+{
+  ARCH_X86_INTEL_FEATURE_AVX2     = 1 << 5,
+  ARCH_X86_INTEL_FEATURE_AVX512F  = 1 << 16
+};
+
+enum
+{
+  ARCH_X86_XCR0_SSE               = 1 << 1,
+  ARCH_X86_XCR0_AVX               = 1 << 2,
+  ARCH_X86_XCR0_AVX512            = 7 << 5
 };
 
 #if !defined(ARCH_X86_64) && (defined(PIC) || defined(__PIC__))
-#define cpuid(op,eax,ebx,ecx,edx)  \
+#define cpuid_count(op,count,eax,ebx,ecx,edx) \
   __asm__ ("movl %%ebx, %%esi\n\t" \
            "cpuid\n\t"             \
            "xchgl %%ebx,%%esi"     \
@@ -127,17 +143,30 @@ enum
              "=S" (ebx),           \
              "=c" (ecx),           \
              "=d" (edx)            \
-           : "0" (op))
+           : "0" (op),             \
+             "2" (count))
 #else
-#define cpuid(op,eax,ebx,ecx,edx)  \
+#define cpuid_count(op,count,eax,ebx,ecx,edx) \
   __asm__ ("cpuid"                 \
            : "=a" (eax),           \
              "=b" (ebx),           \
              "=c" (ecx),           \
              "=d" (edx)            \
-           : "0" (op))
+           : "0" (op),             \
+             "2" (count))
 #endif
 
+#define cpuid(op,eax,ebx,ecx,edx) cpuid_count (op, 0, eax, ebx, ecx, edx)
+
+/* the extended register state has to be enabled by the OS as well,
+ * xgetbv is spelled out for assemblers that don't know it.
+ */
+#define xgetbv(index,eax,edx)      \
+  __asm__ (".byte 0x0f, 0x01, 0xd0" \
+           : "=a" (eax),           \
+             "=d" (edx)            \
+           : "c" (index))
+
 
 static X86Vendor
 arch_get_vendor (void)
@@ -235,6 +264,36 @@ arch_accel_intel (void)
 
     if (ecx & ARCH_X86_INTEL_FEATURE_PNI)
       caps |= GEGL_CPU_ACCEL_X86_SSE3;
+
+    if (ecx & ARCH_X86_INTEL_FEATURE_SSE4_1)
+      caps |= GEGL_CPU_ACCEL_X86_SSE4_1;
+
+    if ((ecx & ARCH_X86_INTEL_FEATURE_OSXSAVE) &&
+        (ecx & ARCH_X86_INTEL_FEATURE_AVX))
+      {
+        guint32 xcr0, xcr0_high, max_op;
+
+        cpuid (0, max_op, ebx, ecx, edx);
+        xgetbv (0, xcr0, xcr0_high);
+
+        if ((xcr0 & (ARCH_X86_XCR0_SSE | ARCH_X86_XCR0_AVX)) ==
+            (ARCH_X86_XCR0_SSE | ARCH_X86_XCR0_AVX))
+          {
+            caps |= GEGL_CPU_ACCEL_X86_AVX;
+
+            if (max_op >= 7)
+              {
+                cpuid_count (7, 0, eax, ebx, ecx, edx);
+
+                if (ebx & ARCH_X86_INTEL_FEATURE_AVX2)
+                  caps |= GEGL_CPU_ACCEL_X86_AVX2;
+
+                if ((ebx & ARCH_X86_INTEL_FEATURE_AVX512F) &&
+                    (xcr0 & ARCH_X86_XCR0_AVX512) == ARCH_X86_XCR0_AVX512)
+                  caps |= GEGL_CPU_ACCEL_X86_AVX512F;
+              }
+          }
+      }
 #endif /* USE_SSE */
   }
 #endif /* USE_MMX */
@@ -400,7 +459,12 @@ arch_accel (void)
 
 #ifdef USE_SSE
   if ((caps & GEGL_CPU_ACCEL_X86_SSE) && !arch_accel_sse_os_support ())
-    caps &= ~(GEGL_CPU_ACCEL_X86_SSE | GEGL_CPU_ACCEL_X86_SSE2);
+    caps &= ~(GEGL_CPU_ACCEL_X86_SSE    |
+              GEGL_CPU_ACCEL_X86_SSE2   |
+              GEGL_CPU_ACCEL_X86_SSE4_1 |
+              GEGL_CPU_ACCEL_X86_AVX    |
+              GEGL_CPU_ACCEL_X86_AVX2   |
+              GEGL_CPU_ACCEL_X86_AVX512F);
 #endif
 
   return caps;
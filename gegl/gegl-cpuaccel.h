@@ -34,6 +34,10 @@ typedef enum
   GEGL_CPU_ACCEL_X86_SSE     = 0x10000000,
   GEGL_CPU_ACCEL_X86_SSE2    = 0x08000000,
   GEGL_CPU_ACCEL_X86_SSE3    = 0x02000000,
+  GEGL_CPU_ACCEL_X86_SSE4_1  = 0x00800000,
+  GEGL_CPU_ACCEL_X86_AVX     = 0x00400000,
+  GEGL_CPU_ACCEL_X86_AVX2    = 0x00200000,
+  GEGL_CPU_ACCEL_X86_AVX512F = 0x00100000,
 
   /* powerpc accelerations */
   GEGL_CPU_ACCEL_PPC_ALTIVEC = 0x04000000
@@ -43,6 +47,66 @@ typedef enum
 GeglCpuAccelFlags  gegl_cpu_accel_get_support (void);
 
 
+/* Multi-versioned kernels.
+ *
+ * An operation marks its kernel GEGL_CPU_ACCEL_INLINE and expands
+ * GEGL_CPU_ACCEL_DEFINE_CLONES for it, which compiles the same body once
+ * more for each instruction set baseline distro builds can't assume.
+ * NAME_select() then returns the best version the CPU supports, and is
+ * meant to be called once from class_init:
+ *
+ *   static GEGL_CPU_ACCEL_INLINE gboolean
+ *   process (GeglOperation *op, void *in_buf, void *out_buf,
+ *            glong samples, const GeglRectangle *roi, gint level)
+ *   { ... }
+ *
+ *   GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+ *     (GeglOperation *op, void *in_buf, void *out_buf,
+ *      glong samples, const GeglRectangle *roi, gint level),
+ *     (op, in_buf, out_buf, samples, roi, level))
+ *
+ *   point_filter_class->process = process_select ();
+ */
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) && \
+    (defined(__i386__) || defined(__x86_64__))
+
+#define GEGL_CPU_ACCEL_CLONES     1
+#define GEGL_CPU_ACCEL_INLINE     inline __attribute__ ((always_inline))
+#define GEGL_CPU_ACCEL_TARGET(t)  __attribute__ ((target (t)))
+
+#define GEGL_CPU_ACCEL_DEFINE_CLONES(ret, name, params, args)           \
+  static GEGL_CPU_ACCEL_TARGET ("sse4.1")                               \
+  ret name##_sse4_1 params { return name args; }                        \
+  static GEGL_CPU_ACCEL_TARGET ("avx2")                                 \
+  ret name##_avx2 params { return name args; }                          \
+  static GEGL_CPU_ACCEL_TARGET ("avx512f")                              \
+  ret name##_avx512f params { return name args; }                       \
+  static ret (*name##_select (void)) params                             \
+  {                                                                     \
+    GeglCpuAccelFlags flags = gegl_cpu_accel_get_support ();            \
+                                                                        \
+    if (flags & GEGL_CPU_ACCEL_X86_AVX512F)                             \
+      return name##_avx512f;                                            \
+    else if (flags & GEGL_CPU_ACCEL_X86_AVX2)                           \
+      return name##_avx2;                                               \
+    else if (flags & GEGL_CPU_ACCEL_X86_SSE4_1)                         \
+      return name##_sse4_1;                                             \
+    return name;                                                        \
+  }
+
+#else
+
+#define GEGL_CPU_ACCEL_INLINE     inline
+
+#define GEGL_CPU_ACCEL_DEFINE_CLONES(ret, name, params, args)           \
+  static ret (*name##_select (void)) params                             \
+  {                                                                     \
+    return name;                                                        \
+  }
+
+#endif
+
+
 G_END_DECLS
 
 #endif  /* __GEGL_CPU_ACCEL_H__ */
@@ -0,0 +1,136 @@
+/* This file is part of GEGL
+ *
+ * GEGL is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * GEGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GEGL; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GEGL_FAST_MATH_H__
+#define __GEGL_FAST_MATH_H__
+
+G_BEGIN_DECLS
+
+/**
+ * gegl_fast_math_enabled: (skip)
+ *
+ * Operations call this once per chunk to decide between libm and the
+ * approximations below; it returns TRUE when GeglConfig:quality is below
+ * 1.0, which previews use to trade a little precision for speed.
+ *
+ * Return value: whether the gegl_fast_* functions should be used
+ */
+gboolean gegl_fast_math_enabled (void);
+
+/* The functions below are polynomial approximations free of branches and
+ * calls, so loops using them get vectorized, and widened further in the
+ * kernels built with GEGL_CPU_ACCEL_DEFINE_CLONES.
+ *
+ * Maximum errors, measured against double precision libm:
+ *
+ *   gegl_fast_exp2f   relative 2.7e-6
+ *   gegl_fast_log2f   absolute 2.2e-6 * MAX (1.0, |result|)
+ *   gegl_fast_powf    relative 1.1e-5 for |exponent| <= 4, growing
+ *                     about linearly with larger exponents
+ *   gegl_fast_expf    relative 2.6e-6 * (1.0 + |x|)
+ *   gegl_fast_logf    absolute 1.5e-6 * MAX (1.0, |log2 (x)|)
+ *
+ * Results of the exponentials are clamped to [2^-126, 2^128); arguments
+ * to the logarithms and bases of gegl_fast_powf that are not positive are
+ * treated as the smallest normal float, where libm would return NaN or
+ * -inf.
+ */
+
+typedef union
+{
+  gfloat   f;
+  gint32   i;
+  guint32  u;
+} GeglFastMathBits;
+
+/* The clamping below is done on the bit patterns: comparing floats would
+ * keep the compiler from turning the loops calling these functions into
+ * vector code, as long as it has to preserve floating point exceptions.
+ */
+
+static inline gfloat
+gegl_fast_exp2f (gfloat x)
+{
+  GeglFastMathBits bits;
+  GeglFastMathBits scale;
+  gint             xi;
+  gfloat           f;
+
+  bits.f = x;
+  /* negative values, as unsigned, grow with their magnitude */
+  bits.u = bits.u > 0xc2fc0000u ? 0xc2fc0000u : bits.u; /* -126.0    */
+  bits.i = bits.i > 0x42ffff7d  ? 0x42ffff7d  : bits.i; /*  127.999  */
+  x      = bits.f;
+
+  /* floor, written with a truncation and a comparison */
+  xi = (gint) x;
+  xi = xi - (x < (gfloat) xi);
+  f  = x - (gfloat) xi;
+
+  scale.i = (xi + 127) << 23;
+
+  return scale.f * (1.000002623f + f * (6.930037737e-1f +
+                                   f * (2.414428294e-1f +
+                                   f * (5.201144144e-2f +
+                                   f *  1.353413891e-2f))));
+}
+
+static inline gfloat
+gegl_fast_log2f (gfloat x)
+{
+  GeglFastMathBits bits;
+  gfloat           exponent;
+  gfloat           t;
+
+  /* zero and negative values become the smallest normal float */
+  bits.f = x;
+  bits.i = bits.i < 0x00800000 ? 0x00800000 : bits.i;
+
+  exponent = (gfloat) ((bits.i >> 23) - 127);
+
+  /* the mantissa, in [1.0, 2.0) */
+  bits.i = (bits.i & 0x007fffff) | 0x3f800000;
+  t      = bits.f - 1.0f;
+
+  return exponent + t * (1.442553163f + t * (-7.182820439e-1f +
+                                        t * ( 4.582716227e-1f +
+                                        t * (-2.795400620e-1f +
+                                        t * ( 1.234534532e-1f +
+                                        t *  -2.645819075e-2f)))));
+}
+
+static inline gfloat
+gegl_fast_powf (gfloat x,
+                gfloat y)
+{
+  return gegl_fast_exp2f (y * gegl_fast_log2f (x));
+}
+
+static inline gfloat
+gegl_fast_expf (gfloat x)
+{
+  return gegl_fast_exp2f (x * 1.442695041f);
+}
+
+static inline gfloat
+gegl_fast_logf (gfloat x)
+{
+  return gegl_fast_log2f (x) * 0.693147181f;
+}
+
+G_END_DECLS
+
+#endif
@@ -31,6 +31,8 @@
 #include <gegl-types.h>
 #include <gegl-paramspecs.h>
 #include <gegl-audio-fragment.h>
+#include <gegl-cpuaccel.h>
+#include <gegl-fast-math.h>
 
 G_BEGIN_DECLS
 
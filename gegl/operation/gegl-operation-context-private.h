@@ -60,6 +60,12 @@ struct _GeglOperationContext
                                                                    2 = 1:4,
                                                                    4 = 1:8,
                                                                    6 = 1:16 .. */
+  gboolean       is_nop;        /* the operation passes its input through
+                                   unchanged, see gegl_operation_is_nop() */
+  const Babl    *constant_format; /* when set, the whole output is
+                                     constant_pixel in this format and
+                                     the inputs need not be computed */
+  guchar         constant_pixel[64];
 };
 
 GeglOperationContext *gegl_operation_context_new       (GeglOperation        *operation);
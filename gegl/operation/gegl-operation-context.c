@@ -383,6 +383,13 @@ gegl_operation_context_get_output_maybe_in_place (GeglOperation *operation,
       output = g_object_ref (input);
       gegl_operation_context_take_object (context, "output", G_OBJECT (output));
     }
+  else if (gegl_can_share_input_tiles (operation, input, roi,
+                                       gegl_operation_context_get_level (context)))
+    {
+      /* aligned tiles are shared, not copied */
+      output = gegl_operation_context_get_target (context, "output");
+      gegl_buffer_copy (input, roi, GEGL_ABYSS_NONE, output, roi);
+    }
   else
     {
       output = gegl_operation_context_get_target (context, "output");
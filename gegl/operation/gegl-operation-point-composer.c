@@ -50,6 +50,43 @@ typedef struct ThreadData
   const Babl *output_fish;
 } ThreadData;
 
+/* Writes @out without running process when the classify method of the
+ * operation decides the chunk from the statistics of @in and @aux, in the
+ * formats of their pads. Returns FALSE when process has to run.
+ */
+static gboolean
+process_classified (GeglOperation *operation,
+                    void          *in,
+                    void          *aux,
+                    void          *out,
+                    glong          samples,
+                    gint           level)
+{
+  GeglOperationPointComposerClass *klass      = GEGL_OPERATION_POINT_COMPOSER_GET_CLASS (operation);
+  const Babl                      *in_format  = gegl_operation_get_format (operation, "input");
+  const Babl                      *out_format = gegl_operation_get_format (operation, "output");
+  GeglPointStats                   in_stats;
+  GeglPointStats                   aux_stats;
+  guchar                           pixel[64];
+
+  if (!klass->classify ||
+      babl_format_get_bytes_per_pixel (out_format) > (gint) sizeof (pixel))
+    return FALSE;
+
+  if (in && !gegl_point_stats_compute (in_format, in, samples, &in_stats))
+    return FALSE;
+  if (aux && !gegl_point_stats_compute (gegl_operation_get_format (operation, "aux"),
+                                        aux, samples, &aux_stats))
+    return FALSE;
+
+  return gegl_point_classification_apply (klass->classify (operation,
+                                                           in ? &in_stats : NULL,
+                                                           aux ? &aux_stats : NULL,
+                                                           pixel, level),
+                                          in_format, in, out_format, out,
+                                          pixel, samples);
+}
+
 static void thread_process (gpointer thread_data, gpointer unused)
 {
   ThreadData *data = thread_data;
@@ -72,7 +109,8 @@ static void thread_process (gpointer thread_data, gpointer unused)
   if (data->output_fish)
     output = data->output_tmp;
 
-  if (!data->klass->process (data->operation,
+  if (!process_classified (data->operation, input, aux, output, samples, data->level) &&
+      !data->klass->process (data->operation,
                        input, aux,
                        output, samples,
                        &data->roi, data->level))
@@ -347,9 +385,12 @@ gegl_operation_point_composer_process (GeglOperation       *operation,
 
         while (gegl_buffer_iterator_next (i))
           {
-            point_composer_class->process (operation, input?i->data[read]:NULL,
-                                                      aux?i->data[foo]:NULL,
-                                                      i->data[0], i->length, &(i->roi[0]), level);
+            void *in      = input?i->data[read]:NULL;
+            void *aux_buf = aux?i->data[foo]:NULL;
+
+            if (!process_classified (operation, in, aux_buf, i->data[0], i->length, level))
+              point_composer_class->process (operation, in, aux_buf,
+                                             i->data[0], i->length, &(i->roi[0]), level);
           }
         return TRUE;
       }
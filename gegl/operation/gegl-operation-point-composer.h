@@ -65,7 +65,16 @@ struct _GeglOperationPointComposerClass
                            size_t               global_worksize,
                            const GeglRectangle *roi,
                            gint                 level);
-  gpointer                 pad[4];
+
+  /* optional, like the classify method of #GeglOperationPointFilterClass,
+   * the statistics of a pad are NULL when it has no buffer.
+   */
+  GeglPointClassification (* classify) (GeglOperation        *self,
+                                        const GeglPointStats *in_stats,
+                                        const GeglPointStats *aux_stats,
+                                        void                 *out_pixel,
+                                        gint                  level);
+  gpointer                 pad[3];
 };
 
 GType gegl_operation_point_composer_get_type (void) G_GNUC_CONST;
@@ -25,7 +25,9 @@
 #include "gegl-debug.h"
 #include "gegl-operation-point-filter.h"
 #include "gegl-operation-context.h"
+#include "gegl-operations.h"
 #include "gegl-config.h"
+#include "gegl-lookup.h"
 #include <sys/types.h>
 #include <unistd.h>
 #include <string.h>
@@ -33,9 +35,15 @@
 #include "opencl/gegl-cl.h"
 #include "gegl-buffer-cl-iterator.h"
 
+typedef struct
+{
+  const Babl                      *format;
+  GeglOperationPointFilterProcess  process;
+} FormatProcess;
+
 typedef struct ThreadData
 {
-  GeglOperationPointFilterClass *klass;
+  GeglOperationPointFilterProcess  process;
   GeglOperation                   *operation;
   guchar                          *input;
   guchar                          *output;
@@ -51,6 +59,53 @@ typedef struct ThreadData
   const Babl *output_fish;
 } ThreadData;
 
+/* Asks the classify method of the operation, if any, about @samples pixels
+ * at @in, in the input format. @pixel receives the output pixel when
+ * GEGL_POINT_CONSTANT is returned.
+ */
+static GeglPointClassification
+classify_chunk (GeglOperation *operation,
+                const void    *in,
+                glong          samples,
+                gint           level,
+                guchar        *pixel)
+{
+  GeglOperationPointFilterClass *klass      = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
+  const Babl                    *out_format = gegl_operation_get_format (operation, "output");
+  GeglPointStats                 stats;
+
+  if (!klass->classify || !in ||
+      babl_format_get_bytes_per_pixel (out_format) > 64 ||
+      !gegl_point_stats_compute (gegl_operation_get_format (operation, "input"),
+                                 in, samples, &stats))
+    return GEGL_POINT_PROCESS;
+
+  return klass->classify (operation, &stats, pixel, level);
+}
+
+/* Writes @out without running process when the operation classifies the
+ * chunk, returns FALSE when process has to run.
+ */
+static gboolean
+process_classified (GeglOperation *operation,
+                    void          *in,
+                    void          *out,
+                    glong          samples,
+                    gint           level)
+{
+  guchar pixel[64];
+
+  if (!GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation)->classify)
+    return FALSE;
+
+  return gegl_point_classification_apply (classify_chunk (operation, in, samples,
+                                                          level, pixel),
+                                          gegl_operation_get_format (operation, "input"),
+                                          in,
+                                          gegl_operation_get_format (operation, "output"),
+                                          out, pixel, samples);
+}
+
 static void thread_process (gpointer thread_data, gpointer unused)
 {
   ThreadData *data = thread_data;
@@ -67,7 +122,8 @@ static void thread_process (gpointer thread_data, gpointer unused)
   if (data->output_fish)
     output = data->output_tmp;
 
-  if (!data->klass->process (data->operation,
+  if (!process_classified (data->operation, input, output, samples, data->level) &&
+      !data->process (data->operation,
                        input, 
                        output, samples,
                        &data->roi, data->level))
@@ -90,6 +146,154 @@ static GThreadPool *thread_pool (void)
   return pool;
 }
 
+static GeglOperationPointFilterProcess get_special_process (GeglOperation *operation);
+
+typedef struct
+{
+  guchar *in_tmp;
+  guchar *out_tmp;
+  gint    in_size;
+  gint    out_size;
+} SparseScratch;
+
+typedef struct
+{
+  GeglOperation                   *operation;
+  GeglOperationPointFilterProcess  process;
+  GeglBuffer                      *output;
+  const Babl                      *input_fish;
+  const Babl                      *out_format;
+  gint                             in_bpp;
+  gint                             out_bpp;
+  gint                             level;
+} SparseData;
+
+static guchar *
+sparse_scratch_get (guchar **buf,
+                    gint    *size,
+                    gint     needed)
+{
+  if (*size < needed)
+    {
+      if (*buf)
+        gegl_free (*buf);
+      *buf  = gegl_malloc (needed);
+      *size = needed;
+    }
+  return *buf;
+}
+
+static void
+sparse_scratch_free (SparseScratch *scratch)
+{
+  if (scratch->in_tmp)
+    gegl_free (scratch->in_tmp);
+  if (scratch->out_tmp)
+    gegl_free (scratch->out_tmp);
+}
+
+static void
+sparse_chunk (GeglBufferIterator *i,
+              gpointer            state,
+              gpointer            user_data)
+{
+  SparseData    *data    = user_data;
+  SparseScratch *scratch = state;
+  glong          samples = i->length;
+  guchar        *in      = i->data[0];
+  guchar        *out;
+  guchar         pixel[64];
+
+  out = sparse_scratch_get (&scratch->out_tmp, &scratch->out_size,
+                            data->out_bpp * samples);
+
+  if (data->input_fish)
+    {
+      in = sparse_scratch_get (&scratch->in_tmp, &scratch->in_size,
+                               data->in_bpp * samples);
+      babl_process (data->input_fish, i->data[0], in, samples);
+    }
+
+  switch (classify_chunk (data->operation, in, samples, data->level, pixel))
+    {
+      case GEGL_POINT_PASSTHROUGH:
+        /* the output already shares this part of the input */
+        return;
+
+      case GEGL_POINT_CONSTANT:
+        gegl_memset_pattern (out, pixel, data->out_bpp, samples);
+        break;
+
+      default:
+        data->process (data->operation, in, out, samples, &i->roi[0], data->level);
+        break;
+    }
+
+  /* the input is in the output format, writing only what differs from it
+   * leaves the tiles that didn't change shared.
+   */
+  if (memcmp (out, i->data[0], data->out_bpp * samples))
+    gegl_buffer_set (data->output, &i->roi[0], data->level,
+                     data->out_format, out, GEGL_AUTO_ROWSTRIDE);
+}
+
+static void
+sparse_merge (gpointer result,
+              gpointer state,
+              gpointer user_data)
+{
+  sparse_scratch_free (state);
+}
+
+/* Processes @result from @input into @output, a copy on write view of
+ * @input set up by gegl_operation_context_get_output_maybe_in_place(),
+ * writing only the chunks the operation changes.
+ */
+static gboolean
+gegl_operation_point_filter_process_sparse (GeglOperation       *operation,
+                                            GeglBuffer          *input,
+                                            GeglBuffer          *output,
+                                            const GeglRectangle *result,
+                                            gint                 level)
+{
+  GeglOperationPointFilterClass *klass      = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
+  const Babl                    *in_format  = gegl_operation_get_format (operation, "input");
+  const Babl                    *out_format = gegl_operation_get_format (operation, "output");
+  SparseScratch                  scratch    = { NULL, };
+  SparseData                     data;
+  GeglBufferIterator            *i;
+
+  data.operation  = operation;
+  data.process    = get_special_process (operation);
+  data.output     = output;
+  data.input_fish = in_format != out_format ? babl_fish (out_format, in_format) : NULL;
+  data.out_format = out_format;
+  data.in_bpp     = babl_format_get_bytes_per_pixel (in_format);
+  data.out_bpp    = babl_format_get_bytes_per_pixel (out_format);
+  data.level      = level;
+
+  if (!data.process)
+    data.process = klass->process;
+
+  i = gegl_buffer_iterator_new (input, result, level, out_format,
+                                GEGL_ACCESS_READ, GEGL_ABYSS_NONE);
+
+  if (gegl_operation_use_threading (operation, result))
+    {
+      gegl_buffer_iterator_foreach (i, sparse_chunk, &scratch, sizeof (scratch),
+                                    sparse_merge, &data);
+    }
+  else
+    {
+      while (gegl_buffer_iterator_next (i))
+        sparse_chunk (i, &scratch, &data);
+    }
+
+  sparse_scratch_free (&scratch);
+
+  return TRUE;
+}
+
 static gboolean
 gegl_operation_filter_process (GeglOperation        *operation,
                                  GeglOperationContext *context,
@@ -115,22 +319,25 @@ gegl_operation_filter_process (GeglOperation        *operation,
     return TRUE;
   }
 
-  input = gegl_operation_context_get_source (context, "input");
-
-  if (op_class->want_in_place && 
-      gegl_can_do_inplace_processing (operation, input, result))
-    {
-      output = g_object_ref (input);
-      gegl_operation_context_take_object (context, "output", G_OBJECT (output));
-    }
-  else
-    {
-      output = gegl_operation_context_get_target (context, "output");
-    }
+  input  = gegl_operation_context_get_source (context, "input");
+  output = gegl_operation_context_get_output_maybe_in_place (operation,
+                                                             context,
+                                                             input,
+                                                             result);
 
   if (input != NULL)
     {
-      success = klass->process (operation, input, output, result, level);
+      /* an output sharing the tiles of the input only has the tiles that
+       * change written to, which needs the pixels processed on the CPU
+       */
+      if (output != input &&
+          gegl_can_share_input_tiles (operation, input, result, level) &&
+          !(gegl_operation_use_opencl (operation) && op_class->opencl_support))
+        success = gegl_operation_point_filter_process_sparse (operation, input,
+                                                              output, result,
+                                                              level);
+      else
+        success = klass->process (operation, input, output, result, level);
 
       if (input)
         g_object_unref (input);
@@ -153,6 +360,488 @@ static gboolean gegl_operation_point_filter_process
 
 G_DEFINE_TYPE (GeglOperationPointFilter, gegl_operation_point_filter, GEGL_TYPE_OPERATION_FILTER)
 
+void
+gegl_operation_point_filter_class_add_format (GeglOperationPointFilterClass   *klass,
+                                              const gchar                     *format,
+                                              GeglOperationPointFilterProcess  process)
+{
+  FormatProcess *entry;
+
+  g_return_if_fail (GEGL_IS_OPERATION_POINT_FILTER_CLASS (klass));
+  g_return_if_fail (format != NULL);
+  g_return_if_fail (process != NULL);
+
+  entry = g_new (FormatProcess, 1);
+  entry->format  = babl_format (format);
+  entry->process = process;
+
+  /* prepending leaves the list of a parent class, which this one started
+   * out sharing, untouched.
+   */
+  klass->formats = g_slist_prepend (klass->formats, entry);
+}
+
+static GeglOperationPointFilterProcess
+get_format_process (GeglOperationPointFilterClass *klass,
+                    const Babl                    *format)
+{
+  GSList *iter;
+
+  for (iter = klass->formats; iter; iter = iter->next)
+    {
+      FormatProcess *entry = iter->data;
+
+      if (entry->format == format)
+        return entry->process;
+    }
+
+  return NULL;
+}
+
+/* the tables of an operation using a transfer function, built on first use
+ * and dropped whenever one of its properties changes. The kernels hold the
+ * reader lock while they use them.
+ */
+typedef struct
+{
+  GRWLock     lock;
+  gboolean    valid_u8;
+  gboolean    valid_u16;
+  GeglLookup *lookup;
+  guint8      u8[256];
+  guint16     u16[65536];
+} TransferTables;
+
+typedef enum
+{
+  TRANSFER_TABLE_U8,
+  TRANSFER_TABLE_U16,
+  TRANSFER_TABLE_LOOKUP
+} TransferTable;
+
+static GQuark
+gegl_transfer_tables_quark (void)
+{
+  static GQuark the_quark = 0;
+
+  if (G_UNLIKELY (the_quark == 0))
+    the_quark = g_quark_from_static_string ("gegl-point-filter-transfer-tables");
+
+  return the_quark;
+}
+
+static void
+transfer_tables_free (gpointer data)
+{
+  TransferTables *tables = data;
+
+  if (tables->lookup)
+    gegl_lookup_free (tables->lookup);
+  g_rw_lock_clear (&tables->lock);
+  g_free (tables);
+}
+
+static void
+transfer_tables_invalidate (GObject    *object,
+                            GParamSpec *pspec,
+                            gpointer    data)
+{
+  TransferTables *tables = data;
+
+  g_rw_lock_writer_lock (&tables->lock);
+  tables->valid_u8  = FALSE;
+  tables->valid_u16 = FALSE;
+  if (tables->lookup)
+    {
+      gegl_lookup_free (tables->lookup);
+      tables->lookup = NULL;
+    }
+  g_rw_lock_writer_unlock (&tables->lock);
+}
+
+static TransferTables *
+get_transfer_tables (GeglOperation *operation)
+{
+  static GMutex   mutex;
+  TransferTables *tables;
+
+  g_mutex_lock (&mutex);
+
+  tables = g_object_get_qdata (G_OBJECT (operation),
+                               gegl_transfer_tables_quark ());
+  if (!tables)
+    {
+      tables = g_new0 (TransferTables, 1);
+      g_rw_lock_init (&tables->lock);
+      g_object_set_qdata_full (G_OBJECT (operation),
+                               gegl_transfer_tables_quark (),
+                               tables, transfer_tables_free);
+      g_signal_connect (operation, "notify",
+                        G_CALLBACK (transfer_tables_invalidate), tables);
+    }
+
+  g_mutex_unlock (&mutex);
+
+  return tables;
+}
+
+static inline gfloat
+transfer_clamped (GeglOperationPointFilterClass *klass,
+                  GeglOperation                 *operation,
+                  gfloat                         value)
+{
+  gfloat result = klass->transfer (value, operation);
+
+  /* written so that NaN ends up as 0.0 */
+  if (!(result > 0.0f))
+    return 0.0f;
+  return MIN (result, 1.0f);
+}
+
+static gboolean
+transfer_table_is_valid (TransferTables *tables,
+                         TransferTable   table)
+{
+  switch (table)
+    {
+      case TRANSFER_TABLE_U8:
+        return tables->valid_u8;
+      case TRANSFER_TABLE_U16:
+        return tables->valid_u16;
+      default:
+        return tables->lookup != NULL;
+    }
+}
+
+/* called with the writer lock held */
+static void
+transfer_table_build (GeglOperation  *operation,
+                      TransferTables *tables,
+                      TransferTable   table)
+{
+  GeglOperationPointFilterClass *klass = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
+  gint                           v;
+
+  if (transfer_table_is_valid (tables, table))
+    return;
+
+  switch (table)
+    {
+      case TRANSFER_TABLE_U8:
+        for (v = 0; v < 256; v++)
+          tables->u8[v] = transfer_clamped (klass, operation, v / 255.0f) * 255.0f + 0.5f;
+        tables->valid_u8 = TRUE;
+        break;
+
+      case TRANSFER_TABLE_U16:
+        for (v = 0; v < 65536; v++)
+          tables->u16[v] = transfer_clamped (klass, operation, v / 65535.0f) * 65535.0f + 0.5f;
+        tables->valid_u16 = TRUE;
+        break;
+
+      default:
+        tables->lookup = gegl_lookup_new ((GeglLookupFunction) klass->transfer,
+                                          operation);
+        break;
+    }
+}
+
+/* Returns the tables of @operation with @table built and the reader lock
+ * held, release them with transfer_tables_release() once done with them.
+ */
+static TransferTables *
+transfer_tables_acquire (GeglOperation *operation,
+                         TransferTable  table)
+{
+  TransferTables *tables = get_transfer_tables (operation);
+
+  g_rw_lock_reader_lock (&tables->lock);
+
+  /* a property change can slip in between building and reading */
+  while (!transfer_table_is_valid (tables, table))
+    {
+      g_rw_lock_reader_unlock (&tables->lock);
+
+      g_rw_lock_writer_lock (&tables->lock);
+      transfer_table_build (operation, tables, table);
+      g_rw_lock_writer_unlock (&tables->lock);
+
+      g_rw_lock_reader_lock (&tables->lock);
+    }
+
+  return tables;
+}
+
+static void
+transfer_tables_release (TransferTables *tables)
+{
+  g_rw_lock_reader_unlock (&tables->lock);
+}
+
+static gboolean
+transfer_process_u8 (GeglOperation       *operation,
+                     void                *in_buf,
+                     void                *out_buf,
+                     glong                n_pixels,
+                     const GeglRectangle *roi,
+                     gint                 level)
+{
+  TransferTables *tables = transfer_tables_acquire (operation, TRANSFER_TABLE_U8);
+  const Babl     *format = gegl_operation_get_format (operation, "output");
+  gint            components = babl_format_get_n_components (format);
+  gint            colors = components - (babl_format_has_alpha (format) ? 1 : 0);
+  guint8         *in  = in_buf;
+  guint8         *out = out_buf;
+  gint            c;
+
+  while (n_pixels--)
+    {
+      for (c = 0; c < colors; c++)
+        out[c] = tables->u8[in[c]];
+      for (; c < components; c++)
+        out[c] = in[c];
+
+      in  += components;
+      out += components;
+    }
+
+  transfer_tables_release (tables);
+
+  return TRUE;
+}
+
+static gboolean
+transfer_process_u16 (GeglOperation       *operation,
+                      void                *in_buf,
+                      void                *out_buf,
+                      glong                n_pixels,
+                      const GeglRectangle *roi,
+                      gint                 level)
+{
+  TransferTables *tables = transfer_tables_acquire (operation, TRANSFER_TABLE_U16);
+  const Babl     *format = gegl_operation_get_format (operation, "output");
+  gint            components = babl_format_get_n_components (format);
+  gint            colors = components - (babl_format_has_alpha (format) ? 1 : 0);
+  guint16        *in  = in_buf;
+  guint16        *out = out_buf;
+  gint            c;
+
+  while (n_pixels--)
+    {
+      for (c = 0; c < colors; c++)
+        out[c] = tables->u16[in[c]];
+      for (; c < components; c++)
+        out[c] = in[c];
+
+      in  += components;
+      out += components;
+    }
+
+  transfer_tables_release (tables);
+
+  return TRUE;
+}
+
+static gboolean
+transfer_process_float (GeglOperation       *operation,
+                        void                *in_buf,
+                        void                *out_buf,
+                        glong                n_pixels,
+                        const GeglRectangle *roi,
+                        gint                 level)
+{
+  TransferTables *tables = transfer_tables_acquire (operation, TRANSFER_TABLE_LOOKUP);
+  const Babl     *format = gegl_operation_get_format (operation, "output");
+  gint            components = babl_format_get_n_components (format);
+  gint            colors = components - (babl_format_has_alpha (format) ? 1 : 0);
+  gfloat         *in  = in_buf;
+  gfloat         *out = out_buf;
+  gint            c;
+
+  while (n_pixels--)
+    {
+      for (c = 0; c < colors; c++)
+        out[c] = gegl_lookup (tables->lookup, in[c]);
+      for (; c < components; c++)
+        out[c] = in[c];
+
+      in  += components;
+      out += components;
+    }
+
+  transfer_tables_release (tables);
+
+  return TRUE;
+}
+
+void
+gegl_operation_point_filter_class_set_transfer (GeglOperationPointFilterClass *klass,
+                                                const gchar                   *format,
+                                                gboolean                       bounded,
+                                                gfloat (* transfer) (gfloat   value,
+                                                                     gpointer operation))
+{
+  gchar *prefix;
+
+  g_return_if_fail (GEGL_IS_OPERATION_POINT_FILTER_CLASS (klass));
+  g_return_if_fail (format != NULL && g_str_has_suffix (format, " float"));
+  g_return_if_fail (transfer != NULL);
+
+  klass->transfer        = transfer;
+  klass->transfer_format = babl_format (format);
+
+  /* the integer formats would clip what leaves [0.0, 1.0] */
+  if (!bounded)
+    return;
+
+  prefix = g_strndup (format, strlen (format) - strlen ("float"));
+
+  {
+    gchar *u8  = g_strconcat (prefix, "u8", NULL);
+    gchar *u16 = g_strconcat (prefix, "u16", NULL);
+
+    gegl_operation_point_filter_class_add_format (klass, u8, transfer_process_u8);
+    gegl_operation_point_filter_class_add_format (klass, u16, transfer_process_u16);
+
+    g_free (u8);
+    g_free (u16);
+  }
+
+  g_free (prefix);
+}
+
+static GQuark
+gegl_preferred_format_quark (void)
+{
+  static GQuark the_quark = 0;
+
+  if (G_UNLIKELY (the_quark == 0))
+    the_quark = g_quark_from_static_string ("gegl-point-filter-preferred-format");
+
+  return the_quark;
+}
+
+gboolean
+gegl_operation_point_filter_prefer_format (GeglOperation *operation,
+                                           const Babl    *format)
+{
+  GeglOperationPointFilterClass *klass = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
+
+  if (format && !get_format_process (klass, format))
+    format = NULL;
+
+  if (g_object_get_qdata (G_OBJECT (operation),
+                          gegl_preferred_format_quark ()) == format)
+    return FALSE;
+
+  g_object_set_qdata (G_OBJECT (operation), gegl_preferred_format_quark (),
+                      (gpointer) format);
+  return TRUE;
+}
+
+const Babl *
+gegl_operation_point_filter_get_preferred_format (GeglOperation *operation)
+{
+  return g_object_get_qdata (G_OBJECT (operation),
+                             gegl_preferred_format_quark ());
+}
+
+gboolean
+gegl_operation_point_filter_has_format (GeglOperation *operation,
+                                        const Babl    *format)
+{
+  return get_format_process (GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation),
+                             format) != NULL;
+}
+
+void
+gegl_operation_point_filter_select_format (GeglOperation *operation)
+{
+  GeglOperationPointFilterClass *klass = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
+  const Babl                    *format;
+
+  if (!klass->formats)
+    return;
+
+  /* reading the input as it is avoids a conversion for sure, failing that
+   * use what the graph found the consumers of our output want.
+   */
+  format = gegl_operation_get_source_format (operation, "input");
+
+  if (!format || !get_format_process (klass, format))
+    format = g_object_get_qdata (G_OBJECT (operation),
+                                 gegl_preferred_format_quark ());
+
+  if (format &&
+      format != gegl_operation_get_format (operation, "input") &&
+      get_format_process (klass, format))
+    {
+      GEGL_NOTE (GEGL_DEBUG_PROCESS, "%s processing natively in %s",
+                 gegl_operation_get_name (operation),
+                 babl_get_name (format));
+
+      gegl_operation_set_format (operation, "input", format);
+      gegl_operation_set_format (operation, "output", format);
+    }
+}
+
+/* The kernel to use instead of the class' process for the current formats,
+ * if any.
+ */
+static GeglOperationPointFilterProcess
+get_special_process (GeglOperation *operation)
+{
+  GeglOperationPointFilterClass   *klass      = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
+  const Babl                      *in_format  = gegl_operation_get_format (operation, "input");
+  const Babl                      *out_format = gegl_operation_get_format (operation, "output");
+  GeglOperationPointFilterProcess  process    = NULL;
+
+  if (in_format == out_format)
+    process = get_format_process (klass, in_format);
+
+  /* at full quality float data only goes through the lookup when the
+   * operation has no regular code path.
+   */
+  if (!process &&
+      klass->transfer &&
+      in_format == klass->transfer_format &&
+      out_format == in_format &&
+      (!klass->process || gegl_config ()->quality < 1.0))
+    process = transfer_process_float;
+
+  return process;
+}
+
+gboolean
+gegl_operation_point_filter_process_pixel (GeglOperation *operation,
+                                           const void    *in_pixel,
+                                           void          *out_pixel)
+{
+  GeglOperationPointFilterClass   *klass = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
+  GeglOperationPointFilterProcess  process;
+  const gchar                     *position_dependent;
+  guchar                           in_copy[64];
+  gint                             in_bpp;
+
+  position_dependent = gegl_operation_class_get_key (GEGL_OPERATION_CLASS (klass),
+                                                     "position-dependent");
+  if (position_dependent && !strcmp (position_dependent, "true"))
+    return FALSE;
+
+  process = get_special_process (operation);
+  if (!process)
+    process = klass->process;
+
+  in_bpp = babl_format_get_bytes_per_pixel (gegl_operation_get_format (operation, "input"));
+  if (!process || in_bpp > (gint) sizeof (in_copy))
+    return FALSE;
+
+  /* the kernels are free to scribble over their input */
+  memcpy (in_copy, in_pixel, in_bpp);
+
+  return process (operation, in_copy, out_pixel, 1, GEGL_RECTANGLE (0, 0, 1, 1), 0);
+}
+
 static void prepare (GeglOperation *operation)
 {
   const Babl *format = babl_format ("RGBA float");
@@ -276,19 +965,24 @@ gegl_operation_point_filter_process (GeglOperation       *operation,
   GeglOperationPointFilterClass *point_filter_class = GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation);
   const Babl *in_format   = gegl_operation_get_format (operation, "input");
   const Babl *out_format  = gegl_operation_get_format (operation, "output");
-
+  GeglOperationPointFilterProcess process = get_special_process (operation);
 
   if ((result->width > 0) && (result->height > 0))
     {
       const Babl *in_buf_format  = input?gegl_buffer_get_format(input):NULL;
       const Babl *output_buf_format = output?gegl_buffer_get_format(output):NULL;
 
-      if (gegl_operation_use_opencl (operation) && (operation_class->cl_data || point_filter_class->cl_process))
+      /* the OpenCL kernels only know the format set in prepare */
+      if (!process &&
+          gegl_operation_use_opencl (operation) && (operation_class->cl_data || point_filter_class->cl_process))
       {
         if (gegl_operation_point_filter_cl_process (operation, input, output, result, level))
             return TRUE;
       }
 
+      if (!process)
+        process = point_filter_class->process;
+
       if (gegl_operation_use_threading (operation, result) && result->height > 1)
       {
         gint threads = gegl_config_threads ();
@@ -361,7 +1055,7 @@ gegl_operation_point_filter_process (GeglOperation       *operation,
             
             for (gint j = 0; j < threads; j++)
             {
-              thread_data[j].klass = point_filter_class;
+              thread_data[j].process = process;
               thread_data[j].operation = operation;
               thread_data[j].input = input?((guchar*)i->data[read]) + (bit * j * i->roi[0].width * in_buf_bpp):NULL;
               thread_data[j].output = ((guchar*)i->data[0]) + (bit * j * i->roi[0].width * out_buf_bpp);
@@ -392,8 +1086,11 @@ gegl_operation_point_filter_process (GeglOperation       *operation,
 
         while (gegl_buffer_iterator_next (i))
           {
-            point_filter_class->process (operation, input?i->data[read]:NULL,
-                                                    i->data[0], i->length, &(i->roi[0]), level);
+            void *in = input?i->data[read]:NULL;
+
+            if (!process_classified (operation, in, i->data[0], i->length, level))
+              process (operation, in,
+                       i->data[0], i->length, &(i->roi[0]), level);
           }
         return TRUE;
       }
@@ -65,11 +65,63 @@ struct _GeglOperationPointFilterClass
                            size_t               global_worksize,
                            const GeglRectangle *roi,
                            gint                 level);
-  gpointer                 pad[4];
+
+  /* kernels registered with gegl_operation_point_filter_class_add_format */
+  GSList                  *formats;
+
+  /* set with gegl_operation_point_filter_class_set_transfer */
+  gfloat (* transfer)     (gfloat               value,
+                           gpointer             operation);
+  const Babl              *transfer_format;
+
+  /* optional, looks at the statistics of the input pixels of a chunk before
+   * it is processed and either lets process run or decides the result on
+   * its own, writing the pixel in the output format when returning
+   * GEGL_POINT_CONSTANT. Operations depending on more than the pixel values
+   * should not implement it.
+   */
+  GeglPointClassification (* classify) (GeglOperation        *self,
+                                        const GeglPointStats *in_stats,
+                                        void                 *out_pixel,
+                                        gint                  level);
 };
 
+typedef gboolean (* GeglOperationPointFilterProcess) (GeglOperation       *self,
+                                                      void                *in_buf,
+                                                      void                *out_buf,
+                                                      glong                samples,
+                                                      const GeglRectangle *roi,
+                                                      gint                 level);
+
 GType gegl_operation_point_filter_get_type (void) G_GNUC_CONST;
 
+/* Registers a specialised kernel reading and writing pixels in @format
+ * directly. When the format produced by the node connected to "input" has
+ * such a kernel, the input and output pads are switched to that format after
+ * prepare, avoiding the conversion to and from the format set in prepare.
+ */
+void  gegl_operation_point_filter_class_add_format
+                                  (GeglOperationPointFilterClass   *klass,
+                                   const gchar                     *format,
+                                   GeglOperationPointFilterProcess  process);
+
+/* Declares that the operation applies @transfer to each colour component of
+ * @format, a non premultiplied float format, passing alpha through. The
+ * class then handles the float format through a #GeglLookup when
+ * GeglConfig:quality is below 1.0 or the class has no process of its own.
+ * When @bounded, @transfer maps [0.0, 1.0] into [0.0, 1.0] whatever the
+ * properties, and the u8 and u16 variants of @format are handled natively
+ * too, with exact tables holding the result for every code value. The
+ * tables are rebuilt when a property of the operation changes, @transfer
+ * receives the operation as its data.
+ */
+void  gegl_operation_point_filter_class_set_transfer
+                                  (GeglOperationPointFilterClass   *klass,
+                                   const gchar                     *format,
+                                   gboolean                         bounded,
+                                   gfloat (* transfer) (gfloat   value,
+                                                        gpointer operation));
+
 G_END_DECLS
 
 #endif
@@ -22,6 +22,7 @@
 #include <glib-object.h>
 
 #include "gegl.h"
+#include "gegl-utils.h"
 #include "gegl-operation-point-render.h"
 #include "gegl-operation-context.h"
 
@@ -69,6 +70,40 @@ gegl_operation_point_render_init (GeglOperationPointRender *self)
 }
 
 
+typedef struct
+{
+  GeglOperation *operation;
+  gint           level;
+} RenderData;
+
+static void
+render_chunk (GeglBufferIterator *i,
+              gpointer            unused,
+              gpointer            user_data)
+{
+  RenderData                    *data      = user_data;
+  GeglOperation                 *operation = data->operation;
+  GeglOperationPointRenderClass *point_render_class;
+  gchar                          pixel[128];
+
+  point_render_class = GEGL_OPERATION_POINT_RENDER_GET_CLASS (operation);
+
+  if (point_render_class->uniform &&
+      point_render_class->uniform (operation, &i->roi[0], data->level, pixel))
+    {
+      const Babl *format = gegl_operation_get_format (operation, "output");
+
+      gegl_memset_pattern (i->data[0], pixel,
+                           babl_format_get_bytes_per_pixel (format),
+                           i->length);
+    }
+  else
+    {
+      point_render_class->process (operation, i->data[0], i->length,
+                                   &i->roi[0], data->level);
+    }
+}
+
 static gboolean
 gegl_operation_point_render_process (GeglOperation       *operation,
                                      GeglBuffer          *output,
@@ -90,11 +125,34 @@ gegl_operation_point_render_process (GeglOperation       *operation,
 
   if ((result->width > 0) && (result->height > 0))
     {
-      GeglBufferIterator *i = gegl_buffer_iterator_new (output, result, level, out_format,
-                                                        GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-
-      while (gegl_buffer_iterator_next (i))
-          point_render_class->process (operation, i->data[0], i->length, &i->roi[0], level);
+      GeglBufferIterator *i;
+      RenderData          data;
+
+      /* a single value needs no rendering, and whole tiles of it can all
+       * share the same memory.
+       */
+      if (point_render_class->uniform && level == 0)
+        {
+          gchar pixel[128];
+
+          if (point_render_class->uniform (operation, result, level, pixel))
+            {
+              gegl_buffer_set_color_from_pixel (output, result, pixel, out_format);
+              return TRUE;
+            }
+        }
+
+      i = gegl_buffer_iterator_new (output, result, level, out_format,
+                                    GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
+
+      data.operation = operation;
+      data.level     = level;
+
+      if (gegl_operation_use_threading (operation, result))
+        gegl_buffer_iterator_foreach (i, render_chunk, NULL, 0, NULL, &data);
+      else
+        while (gegl_buffer_iterator_next (i))
+          render_chunk (i, NULL, &data);
     }
 
   return TRUE;
@@ -52,7 +52,16 @@ struct _GeglOperationPointRenderClass
                         glong                samples,   /* number of samples */
                         const GeglRectangle *roi,       /* can be used if position is of importance*/
                         gint                 level);
-  gpointer              pad[4];
+
+  /* optional, returns TRUE and stores the single value in the output
+   * format when all of roi renders to the same pixel, which is then filled
+   * in without calling process.
+   */
+  gboolean (* uniform) (GeglOperation       *self,
+                        const GeglRectangle *roi,
+                        gint                 level,
+                        void                *pixel);
+  gpointer              pad[3];
 };
 
 GType gegl_operation_point_render_get_type (void) G_GNUC_CONST;
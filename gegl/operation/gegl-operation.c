@@ -27,6 +27,7 @@
 #include "gegl-types-internal.h"
 #include "gegl-operation.h"
 #include "gegl-operation-context.h"
+#include "gegl-operation-point-filter.h"
 #include "gegl-operations-util.h"
 #include "graph/gegl-node-private.h"
 #include "graph/gegl-connection.h"
@@ -337,6 +338,9 @@ gegl_operation_prepare (GeglOperation *self)
 
   if (klass->prepare)
     klass->prepare (self);
+
+  if (GEGL_IS_OPERATION_POINT_FILTER (self))
+    gegl_operation_point_filter_select_format (self);
 }
 
 GeglNode *
@@ -464,6 +468,23 @@ gegl_operation_detect (GeglOperation *operation,
   return NULL;
 }
 
+gboolean
+gegl_operation_is_nop (GeglOperation *operation)
+{
+  GeglOperationClass *klass;
+
+  g_return_val_if_fail (GEGL_IS_OPERATION (operation), FALSE);
+
+  klass = GEGL_OPERATION_GET_CLASS (operation);
+
+  if (!klass->is_operation_a_nop ||
+      !gegl_node_has_pad (operation->node, "input") ||
+      !gegl_node_has_pad (operation->node, "output"))
+    return FALSE;
+
+  return klass->is_operation_a_nop (operation);
+}
+
 void
 gegl_operation_set_format (GeglOperation *self,
                            const gchar   *pad_name,
@@ -64,6 +64,27 @@ struct _GeglOperation
 /* the level at which is being operated is stored in the context,
 */
 
+/* Statistics of a chunk of pixels handed to the classify method of point
+ * operations, gathered in the format set on the pad for operations working
+ * on floating point data with at most four components.
+ */
+typedef struct
+{
+  gint     n_components;
+  gboolean uniform;      /* all the pixels are equal, to min and max */
+  gboolean transparent;  /* the format has alpha, and it is 0.0 everywhere */
+  gfloat   min[4];       /* per component minimum and maximum */
+  gfloat   max[4];
+} GeglPointStats;
+
+/* What the classify method of a point operation decided for a chunk */
+typedef enum
+{
+  GEGL_POINT_PROCESS,      /* run process on the chunk */
+  GEGL_POINT_PASSTHROUGH,  /* the output is a copy of "input" */
+  GEGL_POINT_CONSTANT      /* every output pixel is the one classify wrote */
+} GeglPointClassification;
+
 struct _GeglOperationClass
 {
   GObjectClass    parent_class;
@@ -87,7 +108,12 @@ struct _GeglOperationClass
                                   to accelerate rendering; this allows opting in/out
                                   in the sub-classes of these.
                                 */
-  guint64         bit_pad:60;
+  guint           cow_output:1; /* when processing can't be done in place,
+                                   start the output as a copy on write view
+                                   of the input, tiles the operation leaves
+                                   unchanged then stay shared with it.
+                                 */
+  guint64         bit_pad:59;
 
   /* attach this operation with a GeglNode, override this if you are creating a
    * GeglGraph, it is already defined for Filters/Sources/Composers.
@@ -151,7 +177,14 @@ struct _GeglOperationClass
 
   GeglClRunData *cl_data;
 
-  gpointer      pad[9];
+  /* Returns TRUE when the operation passes its "input" through unchanged
+   * with the current property values, for instance an opacity of 1.0. The
+   * graph then hands the input buffer on as the output without processing
+   * the node. Called after prepare.
+   */
+  gboolean      (*is_operation_a_nop)        (GeglOperation *operation);
+
+  gpointer      pad[8];
 };
 
 
@@ -181,6 +214,9 @@ GeglNode       *gegl_operation_detect        (GeglOperation *operation,
                                               gint           x,
                                               gint           y);
 
+/* whether the operation is an identity for its current properties */
+gboolean        gegl_operation_is_nop        (GeglOperation *operation);
+
 
 /* virtual method invokers that change behavior based on the roi being computed,
  * needs a context_id being based that is used for storing context data.
@@ -271,6 +307,21 @@ gboolean gegl_operation_cl_set_kernel_args (GeglOperation *operation,
 gboolean gegl_can_do_inplace_processing      (GeglOperation       *operation,
                                               GeglBuffer          *input,
                                               const GeglRectangle *result);
+gboolean gegl_can_share_input_tiles          (GeglOperation       *operation,
+                                              GeglBuffer          *input,
+                                              const GeglRectangle *result,
+                                              gint                 level);
+gboolean gegl_point_stats_compute            (const Babl          *format,
+                                              const void          *data,
+                                              glong                samples,
+                                              GeglPointStats      *stats);
+gboolean gegl_point_classification_apply     (GeglPointClassification classification,
+                                              const Babl          *in_format,
+                                              const void          *in,
+                                              const Babl          *out_format,
+                                              void                *out,
+                                              const void          *pixel,
+                                              glong                samples);
 
 /**
  * gegl_object_set_has_forked: (skip)
@@ -327,6 +327,105 @@ gboolean gegl_can_do_inplace_processing (GeglOperation       *operation,
   return FALSE;
 }
 
+/* Whether the output can start out as a copy on write view of @input, see
+ * GeglOperationClass::cow_output.
+ */
+gboolean gegl_can_share_input_tiles (GeglOperation       *operation,
+                                     GeglBuffer          *input,
+                                     const GeglRectangle *result,
+                                     gint                 level)
+{
+  if (!input || level != 0)
+    return FALSE;
+  if (!GEGL_OPERATION_GET_CLASS (operation)->cow_output)
+    return FALSE;
+
+  if (gegl_buffer_get_format (input) == gegl_operation_get_format (operation, "output") &&
+      gegl_rectangle_contains (gegl_buffer_get_extent (input), result))
+    return TRUE;
+  return FALSE;
+}
+
+gboolean
+gegl_point_stats_compute (const Babl     *format,
+                          const void     *data,
+                          glong           samples,
+                          GeglPointStats *stats)
+{
+  const Babl   *type_float = babl_type ("float");
+  const gfloat *pixel      = data;
+  gint          components = babl_format_get_n_components (format);
+  gfloat        min[4];
+  gfloat        max[4];
+  gint          c;
+  glong         i;
+
+  if (components > 4 || samples < 1)
+    return FALSE;
+  for (c = 0; c < components; c++)
+    if (babl_format_get_type (format, c) != type_float)
+      return FALSE;
+
+  for (c = 0; c < components; c++)
+    min[c] = max[c] = pixel[c];
+
+  for (i = 1; i < samples; i++)
+    {
+      pixel += components;
+      for (c = 0; c < components; c++)
+        {
+          min[c] = MIN (min[c], pixel[c]);
+          max[c] = MAX (max[c], pixel[c]);
+        }
+    }
+
+  stats->n_components = components;
+  stats->uniform      = TRUE;
+  for (c = 0; c < components; c++)
+    {
+      stats->min[c] = min[c];
+      stats->max[c] = max[c];
+      if (!(min[c] == max[c]))
+        stats->uniform = FALSE;
+    }
+
+  /* alpha is the last component of the formats babl has */
+  stats->transparent = babl_format_has_alpha (format) &&
+                       max[components - 1] <= 0.0f;
+
+  return TRUE;
+}
+
+gboolean
+gegl_point_classification_apply (GeglPointClassification  classification,
+                                 const Babl              *in_format,
+                                 const void              *in,
+                                 const Babl              *out_format,
+                                 void                    *out,
+                                 const void              *pixel,
+                                 glong                    samples)
+{
+  gint bpp = babl_format_get_bytes_per_pixel (out_format);
+
+  switch (classification)
+    {
+      case GEGL_POINT_PASSTHROUGH:
+        if (!in || in_format != out_format)
+          return FALSE;
+        /* in place processing hands the same memory in both */
+        if (out != in)
+          memcpy (out, in, samples * bpp);
+        return TRUE;
+
+      case GEGL_POINT_CONSTANT:
+        gegl_memset_pattern (out, pixel, bpp, samples);
+        return TRUE;
+
+      default:
+        return FALSE;
+    }
+}
+
 static GQuark
 gegl_has_forked_quark (void)
 {
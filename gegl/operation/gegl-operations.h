@@ -36,4 +36,30 @@ void       gegl_operation_class_register_name (GeglOperationClass *klass,
 
 void       gegl_operations_set_licenses_from_string (const gchar *license_str);
 
+/* Switches a point filter to one of its natively supported formats when it
+ * matches what its input provides, called after the operation's prepare.
+ */
+void       gegl_operation_point_filter_select_format (GeglOperation *operation);
+
+/* Hint used by gegl_operation_point_filter_select_format when the input
+ * format has no native kernel. NULL, or a @format without a native kernel
+ * either, drops an earlier hint. Returns TRUE if the hint changed.
+ */
+gboolean   gegl_operation_point_filter_prefer_format (GeglOperation *operation,
+                                                      const Babl    *format);
+
+/* The hint set by gegl_operation_point_filter_prefer_format, or NULL. */
+const Babl *gegl_operation_point_filter_get_preferred_format (GeglOperation *operation);
+
+/* Whether the point filter has a native kernel for @format. */
+gboolean   gegl_operation_point_filter_has_format (GeglOperation *operation,
+                                                   const Babl    *format);
+
+/* Runs a point filter on a single pixel in the formats chosen in prepare,
+ * returns FALSE if the operation depends on more than the pixel value.
+ */
+gboolean   gegl_operation_point_filter_process_pixel (GeglOperation *operation,
+                                                      const void    *in_pixel,
+                                                      void          *out_pixel);
+
 #endif
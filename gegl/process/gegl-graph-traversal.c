@@ -20,6 +20,7 @@
 #include "config.h"
 
 #include <glib-object.h>
+#include <string.h>
 
 #include "gegl-types-internal.h"
 #include "gegl.h"
@@ -38,6 +39,9 @@
 #include "process/gegl-list-visitor.h"
 
 #include "operation/gegl-operation.h"
+#include "operation/gegl-operations.h"
+#include "operation/gegl-operation-point-filter.h"
+#include "operation/gegl-operation-point-render.h"
 #include "operation/gegl-operation-context.h"
 #include "operation/gegl-operation-context-private.h"
 
@@ -153,11 +157,457 @@ gegl_graph_get_bounding_box (GeglGraphTraversal *path)
   return *GEGL_RECTANGLE(0, 0, 0, 0);
 }
 
+static GeglOperationContext *
+gegl_graph_get_source_context (GeglGraphTraversal *path,
+                               GeglNode           *node,
+                               const gchar        *pad_name)
+{
+  GeglPad *pad = gegl_node_get_pad (node, pad_name);
+  GeglPad *source_pad;
+
+  if (!pad)
+    return NULL;
+
+  source_pad = gegl_pad_get_connected_to (pad);
+  if (!source_pad)
+    return NULL;
+
+  return g_hash_table_lookup (path->contexts, gegl_pad_get_node (source_pad));
+}
+
+/* Calls prepare on the operation of @node and checks whether it is a no-op
+ * for its current properties. A no-op hands its input on as output, so its
+ * output pad is given the format of the input for the nodes prepared after
+ * it to pick formats from.
+ */
+static void
+gegl_graph_prepare_operation (GeglGraphTraversal *path,
+                              GeglNode           *node)
+{
+  GeglOperation        *operation = node->operation;
+  GeglOperationContext *context   = g_hash_table_lookup (path->contexts, node);
+
+  gegl_operation_prepare (operation);
+
+  context->is_nop = gegl_operation_is_nop (operation);
+
+  if (context->is_nop)
+    {
+      const Babl *format = gegl_operation_get_source_format (operation, "input");
+
+      GEGL_NOTE (GEGL_DEBUG_PROCESS, "%s is a no-op",
+                 gegl_node_get_debug_name (node));
+
+      if (format)
+        gegl_operation_set_format (operation, "output", format);
+    }
+}
+
+/* Returns the format all consumers in @path read @output_pad in, or NULL if
+ * they disagree.
+ */
+static const Babl *
+gegl_graph_get_consumer_format (GeglGraphTraversal *path,
+                                GeglPad            *output_pad)
+{
+  const Babl *format = NULL;
+  GSList     *targets_iter;
+
+  for (targets_iter = gegl_pad_get_connections (output_pad);
+       targets_iter;
+       targets_iter = g_slist_next (targets_iter))
+    {
+      GeglNode    *target_node = gegl_connection_get_sink_node (targets_iter->data);
+      GeglPad     *target_pad  = gegl_connection_get_sink_pad (targets_iter->data);
+      const Babl  *target_format;
+
+      if (!g_hash_table_contains (path->contexts, target_node))
+        continue;
+
+      target_format = gegl_operation_get_format (target_node->operation,
+                                                 gegl_pad_get_name (target_pad));
+
+      if (!target_format || (format && format != target_format))
+        return NULL;
+
+      format = target_format;
+    }
+
+  return format;
+}
+
+static void
+gegl_graph_report_conversions (GeglGraphTraversal *path)
+{
+  GList *list_iter;
+  gint   conversions = 0;
+
+  for (list_iter = path->dfs_path; list_iter; list_iter = list_iter->next)
+    {
+      GeglNode *node = GEGL_NODE (list_iter->data);
+      GSList   *input_pads;
+
+      for (input_pads = node->input_pads; input_pads; input_pads = input_pads->next)
+        {
+          GeglPad    *source_pad = gegl_pad_get_connected_to (input_pads->data);
+          const Babl *source_format;
+          const Babl *format;
+
+          if (!source_pad)
+            continue;
+
+          source_format = gegl_pad_get_format (source_pad);
+          format = gegl_operation_get_format (node->operation,
+                                              gegl_pad_get_name (input_pads->data));
+
+          if (source_format && format && source_format != format)
+            {
+              GEGL_NOTE (GEGL_DEBUG_PROCESS, "conversion %s -> %s.%s: %s -> %s",
+                         gegl_node_get_debug_name (gegl_pad_get_node (source_pad)),
+                         gegl_node_get_debug_name (node),
+                         gegl_pad_get_name (input_pads->data),
+                         babl_get_name (source_format),
+                         babl_get_name (format));
+              conversions++;
+            }
+        }
+    }
+
+  GEGL_NOTE (GEGL_DEBUG_PROCESS, "%i format conversions in graph", conversions);
+}
+
+/* Prepares @node's operation and updates its have rect and cache extent,
+ * then the meta-operations containing it.
+ */
+static void
+gegl_graph_prepare_node (GeglGraphTraversal *path,
+                         GeglNode           *node)
+{
+  GeglNode *parent;
+
+  g_mutex_lock (&node->mutex);
+
+  gegl_graph_prepare_operation (path, node);
+  node->have_rect = gegl_operation_get_bounding_box (node->operation);
+  node->valid_have_rect = TRUE;
+
+  if (node->cache)
+    {
+      gegl_buffer_set_extent (GEGL_BUFFER (node->cache),
+                              &node->have_rect);
+    }
+
+  g_mutex_unlock (&node->mutex);
+
+  parent = gegl_node_get_parent (node);
+  while (parent != NULL && parent->operation != NULL)
+    {
+      gegl_operation_prepare (parent->operation);
+      parent = gegl_node_get_parent (parent);
+    }
+}
+
+static void
+gegl_graph_prepare_again (GeglGraphTraversal *path)
+{
+  GList *list_iter;
+
+  for (list_iter = path->dfs_path; list_iter; list_iter = list_iter->next)
+    gegl_graph_prepare_node (path, GEGL_NODE (list_iter->data));
+}
+
+static gboolean
+gegl_graph_has_format_kernels (GeglOperation *operation)
+{
+  return GEGL_IS_OPERATION_POINT_FILTER (operation) &&
+         GEGL_OPERATION_POINT_FILTER_GET_CLASS (operation)->formats;
+}
+
+/* The format @node should be hinted to produce: what all of its consumers
+ * read, when it has a native kernel for that and can't process its input
+ * as is. NULL otherwise.
+ */
+static const Babl *
+gegl_graph_get_wanted_format (GeglGraphTraversal *path,
+                              GeglNode           *node)
+{
+  GeglOperation *operation  = node->operation;
+  GeglPad       *output_pad = gegl_node_get_pad (node, "output");
+  const Babl    *format;
+
+  if (!output_pad)
+    return NULL;
+
+  format = gegl_graph_get_consumer_format (path, output_pad);
+
+  if (!format ||
+      format == gegl_operation_get_source_format (operation, "input") ||
+      !gegl_operation_point_filter_has_format (operation, format))
+    return NULL;
+
+  return format;
+}
+
+static GQuark
+gegl_graph_hint_consumers_quark (void)
+{
+  static GQuark the_quark = 0;
+
+  if (G_UNLIKELY (the_quark == 0))
+    the_quark = g_quark_from_static_string ("gegl-graph-hint-consumers");
+
+  return the_quark;
+}
+
+static void
+gegl_graph_weak_ref_free (gpointer data)
+{
+  g_weak_ref_clear (data);
+  g_free (data);
+}
+
+/* Remembers the operations in @path reading @node's output, which its
+ * format hint was found for. Weak references, so that neither a consumer
+ * is kept alive nor a new one is taken for it.
+ */
+static void
+gegl_graph_remember_consumers (GeglGraphTraversal *path,
+                               GeglNode           *node)
+{
+  GPtrArray *consumers = g_ptr_array_new_with_free_func (gegl_graph_weak_ref_free);
+  GSList    *targets_iter;
+
+  for (targets_iter = gegl_pad_get_connections (gegl_node_get_pad (node, "output"));
+       targets_iter;
+       targets_iter = g_slist_next (targets_iter))
+    {
+      GeglNode *target_node = gegl_connection_get_sink_node (targets_iter->data);
+      GWeakRef *ref;
+
+      if (!g_hash_table_contains (path->contexts, target_node))
+        continue;
+
+      ref = g_new (GWeakRef, 1);
+      g_weak_ref_init (ref, target_node->operation);
+      g_ptr_array_add (consumers, ref);
+    }
+
+  g_object_set_qdata_full (G_OBJECT (node->operation),
+                           gegl_graph_hint_consumers_quark (),
+                           consumers, (GDestroyNotify) g_ptr_array_unref);
+}
+
+static gboolean
+gegl_graph_has_same_consumers (GeglGraphTraversal *path,
+                               GeglNode           *node)
+{
+  GPtrArray *consumers = g_object_get_qdata (G_OBJECT (node->operation),
+                                             gegl_graph_hint_consumers_quark ());
+  GSList    *targets_iter;
+  guint      i = 0;
+
+  if (!consumers)
+    return FALSE;
+
+  for (targets_iter = gegl_pad_get_connections (gegl_node_get_pad (node, "output"));
+       targets_iter;
+       targets_iter = g_slist_next (targets_iter))
+    {
+      GeglNode *target_node = gegl_connection_get_sink_node (targets_iter->data);
+      GObject  *operation;
+      gboolean  same;
+
+      if (!g_hash_table_contains (path->contexts, target_node))
+        continue;
+
+      if (i == consumers->len)
+        return FALSE;
+
+      operation = g_weak_ref_get (g_ptr_array_index (consumers, i++));
+      same = operation == G_OBJECT (target_node->operation);
+
+      if (operation)
+        g_object_unref (operation);
+
+      if (!same)
+        return FALSE;
+    }
+
+  return i == consumers->len;
+}
+
+/* Whether the hints in @path are still what negotiating would find. A hint
+ * matching what its consumers read only counts when they are the ones it
+ * was found for, consumers following their input would otherwise keep
+ * asking for a hint found for an earlier shape of the graph.
+ */
+static gboolean
+gegl_graph_formats_settled (GeglGraphTraversal *path)
+{
+  GList *list_iter;
+
+  for (list_iter = path->dfs_path; list_iter; list_iter = list_iter->next)
+    {
+      GeglNode      *node      = GEGL_NODE (list_iter->data);
+      GeglOperation *operation = node->operation;
+      const Babl    *hint;
+
+      if (!gegl_graph_has_format_kernels (operation))
+        continue;
+
+      hint = gegl_operation_point_filter_get_preferred_format (operation);
+
+      if (gegl_graph_get_wanted_format (path, node) != hint ||
+          (hint && !gegl_graph_has_same_consumers (path, node)))
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* Drops all hints and prepares the graph without them, then hints what
+ * the consumers read on their own and prepares it again. Nodes downstream
+ * of a hinted one are prepared again, so operations following their input
+ * format pick it up.
+ */
+static void
+gegl_graph_find_format_hints (GeglGraphTraversal *path)
+{
+  GList    *list_iter;
+  gboolean  changed = FALSE;
+
+  for (list_iter = path->dfs_path; list_iter; list_iter = list_iter->next)
+    {
+      GeglOperation *operation = GEGL_NODE (list_iter->data)->operation;
+
+      if (!gegl_graph_has_format_kernels (operation))
+        continue;
+
+      g_object_set_qdata (G_OBJECT (operation),
+                          gegl_graph_hint_consumers_quark (), NULL);
+
+      if (gegl_operation_point_filter_prefer_format (operation, NULL))
+        changed = TRUE;
+    }
+
+  if (changed)
+    gegl_graph_prepare_again (path);
+
+  changed = FALSE;
+
+  for (list_iter = path->bfs_path; list_iter; list_iter = list_iter->next)
+    {
+      GeglNode      *node      = GEGL_NODE (list_iter->data);
+      GeglOperation *operation = node->operation;
+      const Babl    *format;
+
+      if (!gegl_graph_has_format_kernels (operation))
+        continue;
+
+      format = gegl_graph_get_wanted_format (path, node);
+
+      if (!format)
+        continue;
+
+      gegl_graph_remember_consumers (path, node);
+
+      if (gegl_operation_point_filter_prefer_format (operation, format))
+        changed = TRUE;
+    }
+
+  if (changed)
+    gegl_graph_prepare_again (path);
+}
+
+/* Each operation picks its formats in prepare from what its inputs provide,
+ * this propagates format preferences the other way: point filters with
+ * native kernels for several formats that can't process their input as is,
+ * produce whatever all of their consumers read instead, saving the
+ * conversion on every outgoing connection. The graph is only prepared
+ * again when the hints aren't settled.
+ */
+static void
+gegl_graph_negotiate_formats (GeglGraphTraversal *path)
+{
+  if (!gegl_graph_formats_settled (path))
+    gegl_graph_find_format_hints (path);
+
+  if (gegl_debug_flags & GEGL_DEBUG_PROCESS)
+    gegl_graph_report_conversions (path);
+}
+
+/* Finds the nodes producing a single colour over all of their output:
+ * point renders reporting a uniform result for their whole bounding box,
+ * and no-ops and point filters reading from such nodes, which are folded
+ * into new constants by running them on the one pixel. These nodes are
+ * filled with their colour when processing, and nothing upstream of them
+ * gets requested.
+ */
+static void
+gegl_graph_fold_constants (GeglGraphTraversal *path)
+{
+  GList *list_iter;
+
+  for (list_iter = path->dfs_path; list_iter; list_iter = list_iter->next)
+    {
+      GeglNode             *node      = GEGL_NODE (list_iter->data);
+      GeglOperation        *operation = node->operation;
+      GeglOperationContext *context   = g_hash_table_lookup (path->contexts, node);
+      GeglOperationContext *source_context;
+      const Babl           *format    = gegl_operation_get_format (operation, "output");
+      gboolean              is_nop    = context->is_nop || node->passthrough;
+
+      context->constant_format = NULL;
+
+      if (!is_nop && GEGL_IS_OPERATION_POINT_RENDER (operation))
+        {
+          GeglOperationPointRenderClass *klass = GEGL_OPERATION_POINT_RENDER_GET_CLASS (operation);
+
+          if (klass->uniform && format &&
+              babl_format_get_bytes_per_pixel (format) <= (gint) sizeof (context->constant_pixel) &&
+              klass->uniform (operation, &node->have_rect, 0, context->constant_pixel))
+            context->constant_format = format;
+        }
+      else if ((source_context = gegl_graph_get_source_context (path, node, "input")) &&
+               source_context->constant_format)
+        {
+          if (is_nop)
+            {
+              context->constant_format = source_context->constant_format;
+              memcpy (context->constant_pixel, source_context->constant_pixel,
+                      sizeof (context->constant_pixel));
+            }
+          else if (GEGL_IS_OPERATION_POINT_FILTER (operation) && format &&
+                   babl_format_get_bytes_per_pixel (format) <= (gint) sizeof (context->constant_pixel))
+            {
+              const Babl *in_format = gegl_operation_get_format (operation, "input");
+              guchar      in_pixel[sizeof (context->constant_pixel)];
+
+              if (!in_format ||
+                  babl_format_get_bytes_per_pixel (in_format) > (gint) sizeof (in_pixel))
+                continue;
+
+              babl_process (babl_fish (source_context->constant_format, in_format),
+                            source_context->constant_pixel, in_pixel, 1);
+
+              if (gegl_operation_point_filter_process_pixel (operation, in_pixel,
+                                                             context->constant_pixel))
+                context->constant_format = format;
+            }
+        }
+
+      if (context->constant_format)
+        GEGL_NOTE (GEGL_DEBUG_PROCESS, "%s has a constant output",
+                   gegl_node_get_debug_name (node));
+    }
+}
+
 /**
  * gegl_graph_prepare:
  * @path: The traversal path
  *
  * Prepare all nodes, initializing their output formats and have rects.
+ * Nodes that are no-ops or produce a constant colour are found here too.
  */
 void
 gegl_graph_prepare (GeglGraphTraversal *path)
@@ -167,29 +617,6 @@ gegl_graph_prepare (GeglGraphTraversal *path)
   for (list_iter = path->dfs_path; list_iter; list_iter = list_iter->next)
   {
     GeglNode *node = GEGL_NODE (list_iter->data);
-    GeglNode *parent;
-    GeglOperation *operation = node->operation;
-
-    g_mutex_lock (&node->mutex);
-
-    gegl_operation_prepare (operation);
-    node->have_rect = gegl_operation_get_bounding_box (operation);
-    node->valid_have_rect = TRUE;
-
-    if (node->cache)
-      {
-        gegl_buffer_set_extent (GEGL_BUFFER (node->cache),
-                                &node->have_rect);
-      }
-
-    g_mutex_unlock (&node->mutex);
-
-    parent = gegl_node_get_parent (node);
-    while (parent != NULL && parent->operation != NULL)
-      {
-        gegl_operation_prepare (parent->operation);
-        parent = gegl_node_get_parent (parent);
-      }
 
     if (!g_hash_table_contains (path->contexts, node))
       {
@@ -199,7 +626,12 @@ gegl_graph_prepare (GeglGraphTraversal *path)
                              node,
                              context);
       }
+
+    gegl_graph_prepare_node (path, node);
   }
+
+  gegl_graph_negotiate_formats (path);
+  gegl_graph_fold_constants (path);
 }
 
 /**
@@ -292,17 +724,27 @@ gegl_graph_prepare_request (GeglGraphTraversal  *path,
 
       {
         /* Expand request if the operation has a minimum processing requirement */
-        GeglRectangle full_request = gegl_operation_get_cached_region (operation, request);
+        GeglRectangle full_request = context->is_nop ? *request :
+                                     gegl_operation_get_cached_region (operation, request);
 
         gegl_operation_context_set_need_rect (context, &full_request);
 
         /* FIXME: We could trim this down based on the cache, instead of being all or nothing */
         gegl_operation_context_set_result_rect (context, request);
 
+        /* Constant nodes are filled without looking at their inputs */
+        if (context->constant_format)
+          continue;
+
         for (input_pads = node->input_pads; input_pads; input_pads = input_pads->next)
           {
             GeglPad *source_pad = gegl_pad_get_connected_to (input_pads->data);
 
+            /* No-ops only pass on their input */
+            if (context->is_nop &&
+                strcmp (gegl_pad_get_name (input_pads->data), "input"))
+              continue;
+
             if (source_pad)
               {
                 GeglNode             *source_node    = gegl_pad_get_node (source_pad);
@@ -312,7 +754,10 @@ gegl_graph_prepare_request (GeglGraphTraversal  *path,
                 GeglRectangle rect, current_need, new_need;
 
                 /* Combine this need rect with any existing request */
-                rect = gegl_operation_get_required_for_output (operation, pad_name, &full_request);
+                if (context->is_nop)
+                  rect = full_request;
+                else
+                  rect = gegl_operation_get_required_for_output (operation, pad_name, &full_request);
                 current_need = *gegl_operation_context_get_need_rect (source_context);
 
                 gegl_rectangle_bounding_box (&new_need, &rect, &current_need);
@@ -438,7 +883,24 @@ gegl_graph_process (GeglGraphTraversal *path,
                 }
 
               context->level = level;
-              gegl_operation_process (operation, context, "output", &context->need_rect, context->level);
+
+              if (context->constant_format)
+                {
+                  GeglBuffer *output = gegl_operation_context_get_target (context, "output");
+
+                  gegl_buffer_set_color_from_pixel (output, &context->need_rect,
+                                                    context->constant_pixel,
+                                                    context->constant_format);
+                }
+              else if (context->is_nop)
+                {
+                  gegl_operation_context_set_object (context, "output",
+                                                     gegl_operation_context_get_object (context, "input"));
+                }
+              else
+                {
+                  gegl_operation_process (operation, context, "output", &context->need_rect, context->level);
+                }
               operation_result = GEGL_BUFFER (gegl_operation_context_get_object (context, "output"));
 
               if (operation_result && operation_result == (GeglBuffer *)operation->node->cache)
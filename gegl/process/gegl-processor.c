@@ -65,7 +65,10 @@ static void      gegl_processor_set_node     (GeglProcessor         *processor,
                                               GeglNode              *node);
 static void      gegl_processor_constructed  (GObject               *object);
 static gdouble   gegl_processor_progress     (GeglProcessor         *processor);
-static gint      gegl_processor_get_band_size(gint                   size) G_GNUC_CONST;
+static void      gegl_processor_free_work    (gpointer               data);
+static gint      gegl_processor_compare_work (gconstpointer          a,
+                                              gconstpointer          b,
+                                              gpointer               user_data);
 
 
 struct _GeglProcessor
@@ -80,9 +83,16 @@ struct _GeglProcessor
 
   GeglRegion      *valid_region;     /* used when doing unbuffered rendering */
   GeglRegion      *queued_region;
-  GSList          *dirty_rectangles;
+  GSequence       *dirty_rectangles; /* tile aligned work items, nearest
+                                        to the focus point first */
   gint             chunk_size;
 
+  GeglRectangle    viewport;         /* work outside is cancelled */
+  gboolean         has_viewport;
+  gint             focus_x;
+  gint             focus_y;
+  gboolean         has_focus;
+
   gdouble          progress;
 };
 
@@ -139,8 +149,10 @@ gegl_processor_init (GeglProcessor *processor)
   processor->input            = NULL;
   processor->context          = NULL;
   processor->queued_region    = NULL;
-  processor->dirty_rectangles = NULL;
+  processor->dirty_rectangles = g_sequence_new (gegl_processor_free_work);
   processor->chunk_size       = 128 * 128;
+  processor->has_viewport     = FALSE;
+  processor->has_focus        = FALSE;
 }
 
 static void
@@ -188,6 +200,8 @@ gegl_processor_finalize (GObject *self_object)
       gegl_region_destroy (processor->valid_region);
     }
 
+  g_sequence_free (processor->dirty_rectangles);
+
   G_OBJECT_CLASS (gegl_processor_parent_class)->finalize (self_object);
 }
 
@@ -328,7 +342,6 @@ void
 gegl_processor_set_rectangle (GeglProcessor       *processor,
                               const GeglRectangle *rectangle)
 {
-  GSList        *iter;
   GeglRectangle  input_bounding_box;
 
   g_return_if_fail (processor->input != NULL);
@@ -344,7 +357,7 @@ gegl_processor_set_rectangle (GeglProcessor       *processor,
              rectangle->x, rectangle->y, rectangle->width, rectangle->height);
 
   /* if the processor's rectangle isn't already set to the node's bounding box,
-   * then set it and remove processor->dirty_rectangles (set to NULL)  */
+   * then set it and remove processor->dirty_rectangles */
   if (! gegl_rectangle_equal (&processor->rectangle, rectangle))
     {
 #if 0
@@ -358,16 +371,10 @@ gegl_processor_set_rectangle (GeglProcessor       *processor,
       gegl_rectangle_intersect (&processor->rectangle, &processor->rectangle, &bounds);
 #endif
     }
-    {
 
-      /* remove already queued dirty rectangles */
-      for (iter = processor->dirty_rectangles; iter; iter = g_slist_next (iter))
-        {
-          g_slice_free (GeglRectangle, iter->data);
-        }
-      g_slist_free (processor->dirty_rectangles);
-      processor->dirty_rectangles = NULL;
-    }
+  /* remove already queued dirty rectangles */
+  g_sequence_remove_range (g_sequence_get_begin_iter (processor->dirty_rectangles),
+                           g_sequence_get_end_iter (processor->dirty_rectangles));
 
   /* if the node's operation is a sink and it needs the full content then
    * a context will be set up together with a cache and
@@ -402,36 +409,131 @@ gegl_processor_set_rectangle (GeglProcessor       *processor,
   g_object_notify (G_OBJECT (processor), "rectangle");
 }
 
-/* Will generate band_sizes that are adapted to the size of the tiles */
-static gint
-gegl_processor_get_band_size (gint size)
+static void
+gegl_processor_free_work (gpointer data)
 {
-  gint band_size;
+  g_slice_free (GeglRectangle, data);
+}
 
-  band_size = size / 2;
+/* Work items are rendered nearest first to the focus point; an explicitly
+ * set focus, otherwise the center of the viewport or of the processed
+ * rectangle. Coordinates are doubled to keep centers of odd sizes exact.
+ */
+static void
+gegl_processor_get_focus (GeglProcessor *processor,
+                          gint64        *x2,
+                          gint64        *y2)
+{
+  const GeglRectangle *area;
 
-  /* try to make the rects generated match better with potential 2^n sized
-   * tiles, XXX: should be improved to make the next slice fit as well. */
-  if (band_size <= 128)
+  if (processor->has_focus)
     {
-      band_size = MIN(band_size, 64); /* prefer a band_size of 128,
-                                          hoping to hit tiles */
+      *x2 = (gint64) processor->focus_x * 2;
+      *y2 = (gint64) processor->focus_y * 2;
+      return;
     }
-  else if (band_size <= 256)
+
+  area = processor->has_viewport ? &processor->viewport : &processor->rectangle;
+
+  *x2 = (gint64) area->x * 2 + area->width;
+  *y2 = (gint64) area->y * 2 + area->height;
+}
+
+static gint
+gegl_processor_compare_work (gconstpointer a,
+                             gconstpointer b,
+                             gpointer      user_data)
+{
+  const GeglRectangle *ra = a;
+  const GeglRectangle *rb = b;
+  gint64               fx, fy;
+  gint64               dx, dy;
+  gint64               da, db;
+
+  gegl_processor_get_focus (user_data, &fx, &fy);
+
+  dx = (gint64) ra->x * 2 + ra->width  - fx;
+  dy = (gint64) ra->y * 2 + ra->height - fy;
+  da = dx * dx + dy * dy;
+
+  dx = (gint64) rb->x * 2 + rb->width  - fx;
+  dy = (gint64) rb->y * 2 + rb->height - fy;
+  db = dx * dx + dy * dy;
+
+  if (da < db)
+    return -1;
+  if (da > db)
+    return 1;
+  return 0;
+}
+
+static gboolean
+gegl_processor_has_work (GeglProcessor *processor)
+{
+  return ! g_sequence_iter_is_end (
+             g_sequence_get_begin_iter (processor->dirty_rectangles));
+}
+
+/* Adds a work item, clipped to the viewport, to the queue */
+static void
+gegl_processor_queue_work (GeglProcessor       *processor,
+                           const GeglRectangle *rectangle)
+{
+  GeglRectangle work = *rectangle;
+
+  if (processor->has_viewport &&
+      ! gegl_rectangle_intersect (&work, &work, &processor->viewport))
+    return;
+
+  if (gegl_rectangle_is_empty (&work))
+    return;
+
+  g_sequence_insert_sorted (processor->dirty_rectangles,
+                            g_slice_dup (GeglRectangle, &work),
+                            gegl_processor_compare_work, processor);
+}
+
+/* Cuts a rectangle along the tile grid into pieces no bigger than max_area
+ * and queues them, so that each piece renders whole cache tiles.
+ */
+static void
+gegl_processor_split_work (GeglProcessor       *processor,
+                           const GeglRectangle *rectangle,
+                           gint                 max_area)
+{
+  gint chunk_width  = gegl_config ()->tile_width;
+  gint chunk_height = gegl_config ()->tile_height;
+  gint x0, y0;
+  gint x, y;
+
+  while (chunk_width * chunk_height > max_area &&
+         (chunk_width > 1 || chunk_height > 1))
     {
-      band_size = MIN(band_size, 128); /* prefer a band_size of 128,
-                                          hoping to hit tiles */
+      if (chunk_width >= chunk_height)
+        chunk_width /= 2;
+      else
+        chunk_height /= 2;
     }
-  else if (band_size <= 512)
+
+  while (chunk_width * chunk_height * 2 <= max_area)
     {
-      band_size = MIN(band_size, 256); /* prefer a band_size of 128,
-                                          hoping to hit tiles */
+      if (chunk_width <= chunk_height)
+        chunk_width *= 2;
+      else
+        chunk_height *= 2;
     }
 
-  if (band_size < 1)
-    band_size = 1;
+  x0 = rectangle->x - (((rectangle->x % chunk_width) + chunk_width) % chunk_width);
+  y0 = rectangle->y - (((rectangle->y % chunk_height) + chunk_height) % chunk_height);
+
+  for (y = y0; y < rectangle->y + rectangle->height; y += chunk_height)
+    for (x = x0; x < rectangle->x + rectangle->width; x += chunk_width)
+      {
+        GeglRectangle chunk = {x, y, chunk_width, chunk_height};
 
-  return band_size;
+        if (gegl_rectangle_intersect (&chunk, &chunk, rectangle))
+          gegl_processor_queue_work (processor, &chunk);
+      }
 }
 
 /* If the processor's dirty rectangle is too big then it will be cut, added
@@ -458,49 +560,25 @@ render_rectangle (GeglProcessor *processor)
       pxsize = babl_format_get_bytes_per_pixel (format);
     }
 
-  if (processor->dirty_rectangles)
+  if (gegl_processor_has_work (processor))
     {
-      GeglRectangle *dr = processor->dirty_rectangles->data;
+      GSequenceIter *first = g_sequence_get_begin_iter (processor->dirty_rectangles);
+      GeglRectangle  work  = *(GeglRectangle *) g_sequence_get (first);
+      GeglRectangle *dr    = &work;
+
+      /* remove the rectangle that will be processed from the queue */
+      g_sequence_remove (first);
 
       /* If a dirty rectangle is bigger than the max area, then cut it
-       * to smaller pieces */
-      if (dr->height * dr->width > max_area && 1)
+       * to tile aligned pieces, queued by distance from the focus */
+      if (dr->height * dr->width > max_area)
         {
-          gint band_size;
-
-          {
-            GeglRectangle *fragment;
-
-            fragment = g_slice_dup (GeglRectangle, dr);
-
-            /* When splitting a rectangle, we'll do it on the biggest side */
-            if (dr->width > dr->height)
-              {
-                band_size = gegl_processor_get_band_size ( dr->width );
-
-                fragment->width = band_size;
-                dr->width      -= band_size;
-                dr->x          += band_size;
-              }
-            else
-              {
-                band_size = gegl_processor_get_band_size (dr->height);
-
-                fragment->height = band_size;
-                dr->height      -= band_size;
-                dr->y           += band_size;
-              }
-            processor->dirty_rectangles = g_slist_prepend (processor->dirty_rectangles, fragment);
-          }
+          gegl_processor_split_work (processor, dr, max_area);
           return TRUE;
         }
-      /* remove the rectangle that will be processed from the list of dirty ones */
-      processor->dirty_rectangles = g_slist_remove (processor->dirty_rectangles, dr);
 
       if (!dr->width || !dr->height)
         {
-          g_slice_free (GeglRectangle, dr);
-
           return TRUE;
         }
 
@@ -543,7 +621,6 @@ render_rectangle (GeglProcessor *processor)
               /* release the buffer */
               g_free (buf);
             }
-          g_slice_free (GeglRectangle, dr);
         }
       else
         {
@@ -551,11 +628,10 @@ render_rectangle (GeglProcessor *processor)
                            dr, NULL, NULL,
                            GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
            gegl_region_union_with_rect (processor->valid_region, dr);
-           g_slice_free (GeglRectangle, dr);
         }
     }
 
-  return processor->dirty_rectangles != NULL;
+  return gegl_processor_has_work (processor);
 }
 
 
@@ -605,7 +681,7 @@ static gboolean
 gegl_processor_is_rendered (GeglProcessor *processor)
 {
   if (gegl_region_empty (processor->queued_region) &&
-      processor->dirty_rectangles == NULL)
+      ! gegl_processor_has_work (processor))
     return TRUE;
   return FALSE;
 }
@@ -714,15 +790,16 @@ gegl_processor_render (GeglProcessor *processor,
       gegl_region_get_rectangles (region, &rectangles, &n_rectangles);
       gegl_region_destroy (region);
 
-      for (i = 0; i < n_rectangles && i < 1; i++)
+      /* queue all of the missing area at once, letting the queue order
+       * the pieces around the focus point */
+      for (i = 0; i < n_rectangles; i++)
         {
           GeglRectangle  roi = rectangles[i];
           GeglRegion    *tr = gegl_region_rectangle (&roi);
           gegl_region_subtract (processor->queued_region, tr);
           gegl_region_destroy (tr);
 
-          processor->dirty_rectangles = g_slist_prepend (processor->dirty_rectangles,
-                                                         g_slice_dup (GeglRectangle, &roi));
+          gegl_processor_queue_work (processor, &roi);
         }
 
       g_free (rectangles);
@@ -738,7 +815,7 @@ gegl_processor_render (GeglProcessor *processor,
       return FALSE;
     }
   else if (!gegl_region_empty (processor->queued_region) &&
-           !processor->dirty_rectangles)
+           !gegl_processor_has_work (processor))
     { /* XXX: this branch of the else can probably be removed if gegl-processors
          should only work with rectangular queued regions
        */
@@ -756,8 +833,7 @@ gegl_processor_render (GeglProcessor *processor,
           gegl_region_subtract (processor->queued_region, tr);
           gegl_region_destroy (tr);
 
-          processor->dirty_rectangles = g_slist_prepend (processor->dirty_rectangles,
-                                                         g_slice_dup (GeglRectangle, &roi));
+          gegl_processor_queue_work (processor, &roi);
         }
 
       g_free (rectangles);
@@ -777,7 +853,8 @@ gboolean
 gegl_processor_work (GeglProcessor *processor,
                      gdouble       *progress)
 {
-  gboolean   more_work = FALSE;
+  gboolean      more_work = FALSE;
+  GeglRectangle roi;
 
   if (gegl_config()->use_opencl)
     {
@@ -805,7 +882,12 @@ gegl_processor_work (GeglProcessor *processor,
         }
     }
 
-  more_work = gegl_processor_render (processor, &processor->rectangle, progress);
+  roi = processor->rectangle;
+
+  if (processor->has_viewport)
+    gegl_rectangle_intersect (&roi, &roi, &processor->viewport);
+
+  more_work = gegl_processor_render (processor, &roi, progress);
   if (more_work)
     {
       return TRUE;
@@ -854,3 +936,55 @@ void gegl_processor_set_scale (GeglProcessor *processor,
 {
   processor->level = gegl_level_from_scale (scale);
 }
+
+void
+gegl_processor_set_viewport (GeglProcessor       *processor,
+                             const GeglRectangle *viewport)
+{
+  GSequenceIter *iter;
+
+  g_return_if_fail (GEGL_IS_PROCESSOR (processor));
+
+  if (! viewport)
+    {
+      processor->has_viewport = FALSE;
+      g_sequence_sort (processor->dirty_rectangles,
+                       gegl_processor_compare_work, processor);
+      return;
+    }
+
+  processor->viewport     = *viewport;
+  processor->has_viewport = TRUE;
+
+  /* cancel the queued work that scrolled out of view, and trim what
+   * is only partially visible */
+  iter = g_sequence_get_begin_iter (processor->dirty_rectangles);
+  while (! g_sequence_iter_is_end (iter))
+    {
+      GeglRectangle *work = g_sequence_get (iter);
+      GSequenceIter *next = g_sequence_iter_next (iter);
+
+      if (! gegl_rectangle_intersect (work, work, viewport))
+        g_sequence_remove (iter);
+
+      iter = next;
+    }
+
+  g_sequence_sort (processor->dirty_rectangles,
+                   gegl_processor_compare_work, processor);
+}
+
+void
+gegl_processor_set_focus (GeglProcessor *processor,
+                          gint           x,
+                          gint           y)
+{
+  g_return_if_fail (GEGL_IS_PROCESSOR (processor));
+
+  processor->focus_x   = x;
+  processor->focus_y   = y;
+  processor->has_focus = TRUE;
+
+  g_sequence_sort (processor->dirty_rectangles,
+                   gegl_processor_compare_work, processor);
+}
@@ -58,6 +58,32 @@ void gegl_processor_set_scale (GeglProcessor *processor,
 void           gegl_processor_set_rectangle (GeglProcessor       *processor,
                                              const GeglRectangle *rectangle);
 
+/**
+ * gegl_processor_set_viewport:
+ * @processor: a #GeglProcessor
+ * @viewport: the currently visible #GeglRectangle, or NULL to not restrict
+ * processing.
+ *
+ * Restrict processing to the part of the processor's rectangle that is
+ * visible; queued work that scrolled out of @viewport is cancelled, and
+ * the remaining work is done starting from the center of the viewport
+ * unless a focus point is set with #gegl_processor_set_focus.
+ */
+void           gegl_processor_set_viewport  (GeglProcessor       *processor,
+                                             const GeglRectangle *viewport);
+
+/**
+ * gegl_processor_set_focus:
+ * @processor: a #GeglProcessor
+ * @x: x coordinate of the focus point
+ * @y: y coordinate of the focus point
+ *
+ * Make the processor render the queued tiles nearest to (@x, @y) first,
+ * for instance to follow the mouse cursor while panning.
+ */
+void           gegl_processor_set_focus     (GeglProcessor       *processor,
+                                             gint                 x,
+                                             gint                 y);
 
 /**
  * gegl_processor_work:
@@ -74,7 +74,7 @@ static void prepare (GeglOperation *operation)
 /* For GeglOperationPointFilter subclasses, we operate on linear
  * buffers with a pixel count.
  */
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -109,6 +109,22 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong n_pixels,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, n_pixels, roi, level))
+
+/* With the default property values the output is the same as the input,
+ * telling GEGL so lets it hand the input buffer on without processing.
+ */
+static gboolean
+is_operation_a_nop (GeglOperation *operation)
+{
+  GeglProperties *o = GEGL_PROPERTIES (operation);
+
+  return o->contrast == 1.0 && o->brightness == 0.0;
+}
+
 #include "opencl/brightness-contrast.cl.h"
 
 /*
@@ -140,10 +156,12 @@ gegl_op_class_init (GeglOpClass *klass)
 
   /* override the prepare methods of the GeglOperation class */
   operation_class->prepare = prepare;
+  /* report when we do nothing for the current properties */
+  operation_class->is_operation_a_nop = is_operation_a_nop;
   /* override the process method of the point filter class (the process methods
    * of our superclasses deal with the handling on their level of abstraction)
    */
-  point_filter_class->process = process;
+  point_filter_class->process = process_select ();
 
   gegl_operation_class_set_keys (operation_class,
       "name",       "gegl:brightness-contrast",
@@ -152,6 +170,7 @@ gegl_op_class_init (GeglOpClass *klass)
       "description", _("Changes the light level and contrast. This operation operates in linear light, 'contrast' is a scale factor around 50%% gray, and 'brightness' a constant offset to apply after contrast scaling."),
       "cl-source"  , brightness_contrast_cl_source,
       "reference-composition", composition,
+      "commutes-with-resampling", "true",
       NULL);
 }
 
@@ -196,7 +196,7 @@ cm_process_pixel (CmParamsType  *mix,
   d[2] = cm_mix_pixel (&mix->blue,  s[0], s[1], s[2], blue_norm);
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -245,6 +245,11 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong samples,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, samples, roi, level))
+
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -254,7 +259,7 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class = GEGL_OPERATION_CLASS (klass);
   point_filter_class = GEGL_OPERATION_POINT_FILTER_CLASS (klass);
 
-  point_filter_class->process = process;
+  point_filter_class->process = process_select ();
   operation_class->prepare = prepare;
   G_OBJECT_CLASS (klass)->finalize = finalize;
 
@@ -278,6 +278,37 @@ checkerboard_process (GeglOperation       *operation,
 }
 
 
+static gboolean
+checkerboard_uniform (GeglOperation       *operation,
+                      const GeglRectangle *roi,
+                      gint                 level,
+                      void                *pixel)
+{
+  GeglProperties *o = GEGL_PROPERTIES (operation);
+  const Babl *out_format = gegl_operation_get_format (operation, "output");
+  gint        square_width  = o->x / (1 << level);
+  gint        square_height = o->y / (1 << level);
+  gint        tilex, tiley;
+
+  if (square_width < 1 || square_height < 1)
+    return FALSE;
+
+  tilex = TILE_INDEX (roi->x - o->x_offset, square_width);
+  tiley = TILE_INDEX (roi->y - o->y_offset, square_height);
+
+  /* all of roi lies within one square */
+  if (tilex != TILE_INDEX (roi->x + roi->width - 1 - o->x_offset, square_width) ||
+      tiley != TILE_INDEX (roi->y + roi->height - 1 - o->y_offset, square_height))
+    return FALSE;
+
+  if ((tilex + tiley) % 2 == 0)
+    gegl_color_get_pixel (o->color1, out_format, pixel);
+  else
+    gegl_color_get_pixel (o->color2, out_format, pixel);
+
+  return TRUE;
+}
+
 static gboolean
 operation_source_process (GeglOperation       *operation,
                           GeglBuffer          *output,
@@ -288,7 +319,6 @@ operation_source_process (GeglOperation       *operation,
 
   if ((result->width > 0) && (result->height > 0))
     {
-      GeglBufferIterator *iter;
       if (gegl_operation_use_opencl (operation) &&
           babl_format_get_n_components (out_format) == 4 &&
           babl_format_get_type (out_format, 0) == babl_type ("float"))
@@ -316,14 +346,10 @@ operation_source_process (GeglOperation       *operation,
           else
             return TRUE;
         }
-
-      iter = gegl_buffer_iterator_new (output, result, level, out_format,
-                                       GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-
-      while (gegl_buffer_iterator_next (iter))
-        checkerboard_process (operation, iter->data[0], iter->length, &iter->roi[0], level);
     }
-  return TRUE;
+
+  return GEGL_OPERATION_SOURCE_CLASS (gegl_op_parent_class)->process (operation, output,
+                                                                      result, level);
 }
 
 static void
@@ -331,11 +357,15 @@ gegl_op_class_init (GeglOpClass *klass)
 {
   GeglOperationClass            *operation_class;
   GeglOperationSourceClass      *source_class;
+  GeglOperationPointRenderClass *point_render_class;
 
   operation_class = GEGL_OPERATION_CLASS (klass);
   source_class = GEGL_OPERATION_SOURCE_CLASS (klass);
+  point_render_class = GEGL_OPERATION_POINT_RENDER_CLASS (klass);
 
   source_class->process = operation_source_process;
+  point_render_class->process = checkerboard_process;
+  point_render_class->uniform = checkerboard_uniform;
   operation_class->get_bounding_box = get_bounding_box;
   operation_class->prepare = prepare;
 
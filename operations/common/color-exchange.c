@@ -234,6 +234,8 @@ gegl_op_class_init (GeglOpClass *klass)
   object_class->finalize = finalize;
 
   operation_class->prepare     = prepare;
+  /* pixels away from the color are left alone, keep sharing their tiles */
+  operation_class->cow_output  = TRUE;
 
   point_filter_class->process    = process;
   point_filter_class->cl_process = cl_process;
@@ -145,7 +145,7 @@ preprocess (GeglProperties *o)
 /* GeglOperationPointFilter gives us a linear buffer to operate on
  * in our requested pixel format
  */
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -180,6 +180,11 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong n_pixels,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, n_pixels, roi, level))
+
 #include "opencl/gegl-cl.h"
 #include "opencl/color-temperature.cl.h"
 
@@ -270,7 +275,7 @@ gegl_op_class_init (GeglOpClass *klass)
 
   operation_class->prepare = prepare;
 
-  point_filter_class->process    = process;
+  point_filter_class->process    = process_select ();
   point_filter_class->cl_process = cl_process;
 
   operation_class->opencl_support = TRUE;
@@ -211,6 +211,27 @@ process (GeglOperation       *operation,
   return TRUE;
 }
 
+static GeglPointClassification
+classify (GeglOperation        *operation,
+          const GeglPointStats *in_stats,
+          void                 *out_pixel,
+          gint                  level)
+{
+  GeglProperties *o = GEGL_PROPERTIES (operation);
+  gfloat          color[4];
+
+  /* flat areas, like the backgrounds this is mostly used to remove, are
+   * done for a single pixel
+   */
+  if (!in_stats->uniform)
+    return GEGL_POINT_PROCESS;
+
+  gegl_color_get_pixel (o->color, babl_format ("R'G'B'A float"), color);
+  color_to_alpha (color, in_stats->min, out_pixel);
+
+  return GEGL_POINT_CONSTANT;
+}
+
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -244,6 +265,7 @@ gegl_op_class_init (GeglOpClass *klass)
 
   filter_class->process    = process;
   filter_class->cl_process = cl_process;
+  filter_class->classify   = classify;
 
   operation_class->prepare = prepare;
   operation_class->opencl_support = TRUE;
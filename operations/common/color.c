@@ -71,6 +71,19 @@ gegl_color_op_process (GeglOperation       *operation,
   return TRUE;
 }
 
+static gboolean
+gegl_color_op_uniform (GeglOperation       *operation,
+                       const GeglRectangle *roi,
+                       gint                 level,
+                       void                *pixel)
+{
+  GeglProperties *o = GEGL_PROPERTIES (operation);
+
+  gegl_color_get_pixel (o->value, gegl_operation_get_format (operation, "output"),
+                        pixel);
+
+  return TRUE;
+}
 
 static void
 gegl_op_class_init (GeglOpClass *klass)
@@ -82,6 +95,7 @@ gegl_op_class_init (GeglOpClass *klass)
   point_render_class = GEGL_OPERATION_POINT_RENDER_CLASS (klass);
 
   point_render_class->process       = gegl_color_op_process;
+  point_render_class->uniform       = gegl_color_op_uniform;
   operation_class->get_bounding_box = gegl_color_op_get_bounding_box;
   operation_class->prepare          = gegl_color_op_prepare;
 
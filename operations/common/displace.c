@@ -217,6 +217,85 @@ get_invalidated_by_change (GeglOperation       *operation,
   return *result;
 }
 
+typedef struct
+{
+  GeglProperties *o;
+  GeglBuffer     *aux;
+  GeglBuffer     *aux2;
+  const Babl     *aux_format;
+  gint            level;
+  gdouble         cx;
+  gdouble         cy;
+} DisplaceData;
+
+static gfloat *
+get_map_pixels (DisplaceData        *data,
+                GeglBuffer          *map,
+                const GeglRectangle *roi)
+{
+  gfloat *pixels;
+
+  if (! map)
+    return NULL;
+
+  pixels = g_new (gfloat, 2 * roi->width * roi->height);
+  gegl_buffer_get (map, roi, 1.0 / (1 << data->level), data->aux_format,
+                   pixels, GEGL_AUTO_ROWSTRIDE, data->o->abyss_policy);
+
+  return pixels;
+}
+
+/* the displacement is computed in level 0 pixels */
+static void
+displace_coords (const GeglRectangle *roi,
+                 gdouble             *coords,
+                 GeglMatrix2         *scale,
+                 gpointer             user_data)
+{
+  DisplaceData   *data        = user_data;
+  GeglProperties *o           = data->o;
+  const gint      factor      = 1 << data->level;
+  gfloat         *aux_pixels  = get_map_pixels (data, data->aux, roi);
+  gfloat         *aux2_pixels = get_map_pixels (data, data->aux2, roi);
+  gfloat         *aux_pixel   = aux_pixels;
+  gfloat         *aux2_pixel  = aux2_pixels;
+  gint            x, y;
+
+  for (y = roi->y; y < roi->y + roi->height; y++)
+    for (x = roi->x; x < roi->x + roi->width; x++)
+      {
+        gdouble src_x, src_y;
+
+        if (o->displace_mode == GEGL_DISPLACE_MODE_POLAR)
+          {
+            get_input_polar_coordinates (x * factor, y * factor,
+                                         o->amount_x, o->amount_y,
+                                         aux_pixel, aux2_pixel,
+                                         data->cx, data->cy,
+                                         &src_x, &src_y);
+          }
+        else
+          {
+            get_input_cartesian_coordinates (x * factor, y * factor,
+                                             o->amount_x, o->amount_y,
+                                             aux_pixel, aux2_pixel,
+                                             &src_x, &src_y);
+          }
+
+        *coords++ = src_x / factor;
+        *coords++ = src_y / factor;
+
+        if (aux_pixel)
+          aux_pixel += 2;
+
+        if (aux2_pixel)
+          aux2_pixel += 2;
+      }
+
+  g_free (aux_pixels);
+  g_free (aux2_pixels);
+}
+
 static gboolean
 process (GeglOperation       *operation,
          GeglBuffer          *input,
@@ -226,86 +305,28 @@ process (GeglOperation       *operation,
          const GeglRectangle *result,
          gint                 level)
 {
-  GeglProperties     *o = GEGL_PROPERTIES (operation);
-  GeglBufferIterator *iter;
-  GeglSampler        *in_sampler;
-
-  gint     x, y;
-  gdouble  cx = 0, cy = 0;
-  gfloat  *in_pixel;
-  gint     n_components;
-  gint     aux_index, aux2_index;
-
-  const Babl *inout_format = gegl_operation_get_format (operation, "input");
-  const Babl *aux_format  = gegl_operation_get_format (operation, "aux");
-
-  n_components = babl_format_get_n_components (inout_format);
-
-  in_pixel = g_new (gfloat, n_components);
-
-  in_sampler = gegl_buffer_sampler_new_at_level (input, inout_format,
-                                                 o->sampler_type, level);
-
-  iter = gegl_buffer_iterator_new (output, result, level, inout_format,
-                                   GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-
-  if (aux)
-    aux_index = gegl_buffer_iterator_add (iter, aux, result, level, aux_format,
-                                          GEGL_ACCESS_READ, o->abyss_policy);
+  GeglProperties *o = GEGL_PROPERTIES (operation);
+  DisplaceData    data;
 
-  if (aux2)
-    aux2_index = gegl_buffer_iterator_add (iter, aux2, result, level, aux_format,
-                                           GEGL_ACCESS_READ, o->abyss_policy);
+  data.o          = o;
+  data.aux        = aux;
+  data.aux2       = aux2;
+  data.aux_format = gegl_operation_get_format (operation, "aux");
+  data.level      = level;
+  data.cx         = 0;
+  data.cy         = 0;
 
   if (o->displace_mode == GEGL_DISPLACE_MODE_POLAR)
     {
-      cx = gegl_buffer_get_width (input) / 2.0;
-      cy = gegl_buffer_get_height (input) / 2.0;
-    }
-
-  while (gegl_buffer_iterator_next (iter))
-    {
-      gfloat *out_pixel  = iter->data[0];
-      gfloat *aux_pixel  = aux ? iter->data[aux_index] : NULL;
-      gfloat *aux2_pixel = aux2 ? iter->data[aux2_index] : NULL;
-      gint b;
-
-      for (y = iter->roi[0].y; y < iter->roi[0].y + iter->roi[0].height; y++)
-        for (x = iter->roi[0].x; x < iter->roi[0].x + iter->roi[0].width; x++)
-          {
-            gdouble  src_x, src_y;
-
-            if (o->displace_mode == GEGL_DISPLACE_MODE_POLAR)
-              {
-                get_input_polar_coordinates (x, y, o->amount_x, o->amount_y,
-                                             aux_pixel, aux2_pixel, cx, cy,
-                                             &src_x, &src_y);
-              }
-            else
-              {
-                get_input_cartesian_coordinates (x, y, o->amount_x, o->amount_y,
-                                                 aux_pixel, aux2_pixel,
-                                                 &src_x, &src_y);
-              }
-
-            gegl_sampler_get (in_sampler, src_x, src_y, NULL,
-                              in_pixel, o->abyss_policy);
-
-            for (b = 0; b < n_components; b++)
-              out_pixel[b] = in_pixel[b];
-
-            out_pixel += n_components;
-
-            if (aux)
-              aux_pixel += 2;
-
-            if (aux2)
-              aux2_pixel += 2;
-          }
+      data.cx = gegl_buffer_get_width (input) / 2.0;
+      data.cy = gegl_buffer_get_height (input) / 2.0;
     }
 
-  g_free (in_pixel);
-  g_object_unref (in_sampler);
+  gegl_buffer_sample_coords (input, output, result, level,
+                             gegl_operation_get_format (operation, "input"),
+                             o->sampler_type, o->abyss_policy,
+                             FALSE, FALSE,
+                             displace_coords, &data);
 
   return  TRUE;
 }
@@ -56,7 +56,7 @@ prepare (GeglOperation *operation)
 /* GeglOperationPointFilter gives us a linear buffer to operate on
  * in our requested pixel format
  */
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -103,6 +103,28 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong n_pixels,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, n_pixels, roi, level))
+
+static gfloat
+transfer (gfloat   value,
+          gpointer op)
+{
+  GeglProperties *o = GEGL_PROPERTIES (op);
+  gfloat     gain = powf (2.0, o->exposure);
+  gfloat     gamma = 1.0 / o->gamma;
+
+  if (gamma == 1.0)
+    return value * gain + o->offset;
+
+  if (gegl_fast_math_enabled ())
+    return gegl_fast_powf (value * gain + o->offset, gamma);
+
+  return powf (value * gain + o->offset, gamma);
+}
+
 #include "opencl/gegl-cl.h"
 
 static const char* kernel_source =
@@ -178,9 +200,12 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class->opencl_support = TRUE;
   operation_class->prepare        = prepare;
 
-  point_filter_class->process    = process;
+  point_filter_class->process    = process_select ();
   point_filter_class->cl_process = cl_process;
 
+  gegl_operation_point_filter_class_set_transfer (point_filter_class,
+                                                  "RGBA float", FALSE, transfer);
+
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:exposure",
     "title",       _("Exposure"),
@@ -1288,12 +1288,20 @@ fattal02_process (GeglOperation       *operation,
 
   fattal02_tonemap (lum_in, result, lum_out, o->alpha, o->beta, noise);
 
-  for (i = 0; i < result->width * result->height * pix_stride; ++i)
-    {
-      pix[i] = (powf (pix[i] / lum_in[i / pix_stride],
-                      o->saturation) *
-                lum_out[i / pix_stride]);
-    }
+  if (gegl_fast_math_enabled ())
+    for (i = 0; i < result->width * result->height * pix_stride; ++i)
+      {
+        pix[i] = (gegl_fast_powf (pix[i] / lum_in[i / pix_stride],
+                                  o->saturation) *
+                  lum_out[i / pix_stride]);
+      }
+  else
+    for (i = 0; i < result->width * result->height * pix_stride; ++i)
+      {
+        pix[i] = (powf (pix[i] / lum_in[i / pix_stride],
+                        o->saturation) *
+                  lum_out[i / pix_stride]);
+      }
 
   gegl_buffer_set (output, result, 0, babl_format (OUTPUT_FORMAT), pix,
                    GEGL_AUTO_ROWSTRIDE);
@@ -198,6 +198,9 @@ iir_young_hor_blur (GeglBuffer          *src,
   gegl_free (scratch);
 }
 
+/* number of columns fetched and stored together in the vertical passes */
+#define GAUSSIAN_BLUR_COLUMN_BATCH 16
+
 /* expects src and dst buf to have the same width and no x-offset */
 static void
 iir_young_ver_blur (GeglBuffer          *src,
@@ -207,21 +210,38 @@ iir_young_ver_blur (GeglBuffer          *src,
                     gdouble              B,
                     gdouble             *b)
 {
-  gint u;
+  gint u, j;
   const Babl *format = babl_format ("RaGaBaA float");
   const int pixel_count = src_rect->height;
-  gfloat *buf     = gegl_malloc (pixel_count * sizeof(gfloat) * 4);
+  gfloat *buf     = gegl_malloc (pixel_count * sizeof(gfloat) * 4 *
+                                 GAUSSIAN_BLUR_COLUMN_BATCH);
   gfloat *scratch = gegl_malloc (pixel_count * sizeof(gfloat) * 4);
-  GeglRectangle read_rect = {dst_rect->x, src_rect->y, 1, src_rect->height};
+  GeglRectangle read_rect[GAUSSIAN_BLUR_COLUMN_BATCH];
+  gpointer      read_data[GAUSSIAN_BLUR_COLUMN_BATCH];
 
-  for (u = 0; u < dst_rect->width; u++)
+  for (j = 0; j < GAUSSIAN_BLUR_COLUMN_BATCH; j++)
     {
-      read_rect.x = dst_rect->x + u;
-      gegl_buffer_get (src, &read_rect, 1.0, format, buf, GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+      GeglRectangle column = {dst_rect->x, src_rect->y, 1, src_rect->height};
 
-      iir_young_blur_pixels_1D (buf, 4, B, b, scratch, pixel_count);
+      read_rect[j] = column;
+      read_data[j] = buf + j * pixel_count * 4;
+    }
 
-      gegl_buffer_set (dst, &read_rect, 0, format, buf, GEGL_AUTO_ROWSTRIDE);
+  for (u = 0; u < dst_rect->width; u += GAUSSIAN_BLUR_COLUMN_BATCH)
+    {
+      gint n = MIN (GAUSSIAN_BLUR_COLUMN_BATCH, dst_rect->width - u);
+
+      for (j = 0; j < n; j++)
+        read_rect[j].x = dst_rect->x + u + j;
+
+      gegl_buffer_get_many (src, read_rect, n, format, read_data,
+                            GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+      for (j = 0; j < n; j++)
+        iir_young_blur_pixels_1D (read_data[j], 4, B, b, scratch, pixel_count);
+
+      gegl_buffer_set_many (dst, read_rect, n, format, read_data,
+                            GEGL_AUTO_ROWSTRIDE);
     }
 
   gegl_free (buf);
@@ -356,34 +376,60 @@ fir_ver_blur (GeglBuffer          *src,
               gdouble             *cmatrix,
               gint                 matrix_length)
 {
-  gint        u,v;
+  gint        u, v, j;
   const gint  radius = matrix_length / 2;
   const Babl *format = babl_format ("RaGaBaA float");
+  const gint  write_len = dst_rect->height * 4;
+  const gint  read_len  = (dst_rect->height + 2 * radius) * 4;
 
-  GeglRectangle write_rect = {dst_rect->x, dst_rect->y, 1, dst_rect->height};
-  gfloat *dst_buf    = gegl_malloc (write_rect.height * sizeof(gfloat) * 4);
+  GeglRectangle write_rect[GAUSSIAN_BLUR_COLUMN_BATCH];
+  gpointer      write_data[GAUSSIAN_BLUR_COLUMN_BATCH];
+  gfloat *dst_buf    = gegl_malloc (write_len * sizeof(gfloat) *
+                                    GAUSSIAN_BLUR_COLUMN_BATCH);
 
-  GeglRectangle read_rect  = {dst_rect->x, dst_rect->y - radius, 1, dst_rect->height + 2 * radius};
-  gfloat *src_buf    = gegl_malloc (read_rect.height * sizeof(gfloat) * 4);
+  GeglRectangle read_rect[GAUSSIAN_BLUR_COLUMN_BATCH];
+  gpointer      read_data[GAUSSIAN_BLUR_COLUMN_BATCH];
+  gfloat *src_buf    = gegl_malloc (read_len * sizeof(gfloat) *
+                                    GAUSSIAN_BLUR_COLUMN_BATCH);
 
-  for (u = 0; u < dst_rect->width; u++)
+  for (j = 0; j < GAUSSIAN_BLUR_COLUMN_BATCH; j++)
     {
-      gint offset     = 0;
-      read_rect.x     = dst_rect->x + u;
-      write_rect.x    = dst_rect->x + u;
-      gegl_buffer_get (src, &read_rect, 1.0, format, src_buf, GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+      GeglRectangle write_column = {dst_rect->x, dst_rect->y,
+                                    1, dst_rect->height};
+      GeglRectangle read_column  = {dst_rect->x, dst_rect->y - radius,
+                                    1, dst_rect->height + 2 * radius};
+
+      write_rect[j] = write_column;
+      write_data[j] = dst_buf + j * write_len;
+      read_rect[j]  = read_column;
+      read_data[j]  = src_buf + j * read_len;
+    }
+
+  for (u = 0; u < dst_rect->width; u += GAUSSIAN_BLUR_COLUMN_BATCH)
+    {
+      gint n = MIN (GAUSSIAN_BLUR_COLUMN_BATCH, dst_rect->width - u);
 
-      for (v = 0; v < dst_rect->height; v++)
+      for (j = 0; j < n; j++)
+        read_rect[j].x = write_rect[j].x = dst_rect->x + u + j;
+
+      gegl_buffer_get_many (src, read_rect, n, format, read_data,
+                            GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+      for (j = 0; j < n; j++)
         {
-          fir_get_mean_pixel_1D (src_buf + offset,
-                                 dst_buf + offset,
-                                 4,
-                                 cmatrix,
-                                 matrix_length);
-          offset += 4;
+          gfloat *src_column = read_data[j];
+          gfloat *dst_column = write_data[j];
+
+          for (v = 0; v < dst_rect->height; v++)
+            fir_get_mean_pixel_1D (src_column + v * 4,
+                                   dst_column + v * 4,
+                                   4,
+                                   cmatrix,
+                                   matrix_length);
         }
 
-      gegl_buffer_set (dst, &write_rect, 0, format, dst_buf, GEGL_AUTO_ROWSTRIDE);
+      gegl_buffer_set_many (dst, write_rect, n, format, write_data,
+                            GEGL_AUTO_ROWSTRIDE);
     }
 
   gegl_free (src_buf);
@@ -229,6 +229,96 @@ iir_young_hor_blur (GeglBuffer          *src,
   g_free (row);
 }
 
+/* The vertical passes work on blocks of adjacent columns fetched with a
+ * single gegl_buffer_get; the columns of a block are filtered together as
+ * interleaved lanes, so every step reads whole contiguous rows.
+ */
+#define GBLUR_1D_BLOCK_WIDTH 16
+
+static inline void
+iir_young_blur_lanes (gfloat        *buf,
+                      gdouble       *tmp,
+                      const gdouble *b,
+                      gdouble      (*m)[3],
+                      const gint     len,
+                      const gint     lanes,
+                      const gint     stride,
+                      const gint     nc,
+                      GeglAbyssPolicy policy)
+{
+  gfloat  white[4] = { 1, 1, 1, 1 };
+  gfloat  black[4] = { 0, 0, 0, 1 };
+  gfloat  none[4]  = { 0, 0, 0, 0 };
+  gfloat *edge;
+  gint    i, k, l;
+
+  switch (policy)
+    {
+    case GEGL_ABYSS_CLAMP: default:
+      edge = NULL; break;
+
+    case GEGL_ABYSS_NONE:
+      edge = &none[0]; break;
+
+    case GEGL_ABYSS_WHITE:
+      edge = &white[0]; break;
+
+    case GEGL_ABYSS_BLACK:
+      edge = &black[nc == 2 ? 2 : 0]; break;
+    }
+
+  for (l = 0; l < lanes; l++)
+    {
+      gfloat iminus = edge ? edge[l % nc] : buf[3 * stride + l];
+
+      for (i = 0; i < 3; ++i)
+        tmp[i * stride + l] = iminus;
+    }
+
+  for (i = 3; i < 3 + len; ++i)
+    {
+      const gfloat  *in  = &buf[i * stride];
+      gdouble       *out = &tmp[i * stride];
+
+      for (l = 0; l < lanes; l++)
+        out[l] = in[l] * b[0] +
+                 b[1] * out[l - stride] +
+                 b[2] * out[l - 2 * stride] +
+                 b[3] * out[l - 3 * stride];
+    }
+
+  for (l = 0; l < lanes; l++)
+    {
+      gfloat  uplus = edge ? edge[l % nc] : buf[(len + 2) * stride + l];
+      gdouble u[3];
+
+      for (k = 0; k < 3; k++)
+        u[k] = tmp[(3 + len - 1 - k) * stride + l] - uplus;
+
+      for (i = 0; i < 3; i++)
+        {
+          gdouble acc = 0.;
+
+          for (k = 0; k < 3; k++)
+            acc += m[i][k] * u[k];
+
+          tmp[(3 + len + i) * stride + l] = acc + uplus;
+        }
+    }
+
+  for (i = 3 + len - 1; 3 <= i; --i)
+    {
+      gfloat  *out = &buf[i * stride];
+      gdouble *t   = &tmp[i * stride];
+
+      for (l = 0; l < lanes; l++)
+        out[l] = t[l] = b[0] * t[l] +
+                        b[1] * t[l + stride] +
+                        b[2] * t[l + 2 * stride] +
+                        b[3] * t[l + 3 * stride];
+    }
+}
+
 static void
 iir_young_ver_blur (GeglBuffer          *src,
                     const GeglRectangle *rect,
@@ -238,29 +328,30 @@ iir_young_ver_blur (GeglBuffer          *src,
                     GeglAbyssPolicy      policy,
                     const Babl          *format)
 {
-  GeglRectangle  cur_col = *rect;
-  const gint     nc = babl_format_get_n_components (format);
-  gfloat        *col = g_new (gfloat, (3 + rect->height + 3) * nc);
-  gdouble       *tmp = g_new (gdouble, (3 + rect->height + 3));
+  GeglRectangle  cur_block = *rect;
+  const gint     nc    = babl_format_get_n_components (format);
+  const gint     lanes = GBLUR_1D_BLOCK_WIDTH * nc;
+  gfloat        *block = g_new (gfloat, (3 + rect->height + 3) * lanes);
+  gdouble       *tmp   = g_new (gdouble, (3 + rect->height + 3) * lanes);
   gint           i;
 
-  cur_col.width = 1;
-
-  for (i = 0; i < rect->width; i++)
+  for (i = 0; i < rect->width; i += GBLUR_1D_BLOCK_WIDTH)
     {
-      cur_col.x = rect->x + i;
+      cur_block.x     = rect->x + i;
+      cur_block.width = MIN (GBLUR_1D_BLOCK_WIDTH, rect->width - i);
 
-      gegl_buffer_get (src, &cur_col, 1.0, format, &col[3 * nc],
-                       GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+      gegl_buffer_get (src, &cur_block, 1.0, format, &block[3 * lanes],
+                       lanes * sizeof (gfloat), GEGL_ABYSS_NONE);
 
-      iir_young_blur_1D (col, tmp, b, m, rect->height, nc, policy);
+      iir_young_blur_lanes (block, tmp, b, m, rect->height,
+                            cur_block.width * nc, lanes, nc, policy);
 
-      gegl_buffer_set (dst, &cur_col, 0, format, &col[3 * nc],
-                       GEGL_AUTO_ROWSTRIDE);
+      gegl_buffer_set (dst, &cur_block, 0, format, &block[3 * lanes],
+                       lanes * sizeof (gfloat));
     }
 
   g_free (tmp);
-  g_free (col);
+  g_free (block);
 }
 
 
@@ -336,6 +427,36 @@ fir_hor_blur (GeglBuffer          *src,
   gegl_free (row);
 }
 
+static inline void
+fir_blur_lanes (const gfloat *input,
+                      gfloat *output,
+                const gfloat *cmatrix,
+                const gint    clen,
+                const gint    len,
+                const gint    lanes,
+                const gint    stride)
+{
+  gint i;
+
+  for (i = 0; i < len; i++)
+    {
+      gfloat *out = &output[i * stride];
+      gint    l, k;
+
+      for (l = 0; l < lanes; l++)
+        out[l] = 0.0f;
+
+      for (k = 0; k < clen; k++)
+        {
+          const gfloat *in = &input[(i + k) * stride];
+          const gfloat  w  = cmatrix[k];
+
+          for (l = 0; l < lanes; l++)
+            out[l] += in[l] * w;
+        }
+    }
+}
+
 static void
 fir_ver_blur (GeglBuffer          *src,
               const GeglRectangle *rect,
@@ -345,35 +466,39 @@ fir_ver_blur (GeglBuffer          *src,
               GeglAbyssPolicy      policy,
               const Babl          *format)
 {
-  GeglRectangle  cur_col = *rect;
-  GeglRectangle  in_col;
-  const gint     nc = babl_format_get_n_components (format);
-  gfloat        *col;
+  GeglRectangle  cur_block = *rect;
+  GeglRectangle  in_block;
+  const gint     nc    = babl_format_get_n_components (format);
+  const gint     lanes = GBLUR_1D_BLOCK_WIDTH * nc;
+  gfloat        *block;
   gfloat        *out;
   gint           v;
 
-  cur_col.width = 1;
-
-  in_col         = cur_col;
-  in_col.height += clen - 1;
-  in_col.y      -= clen / 2;
+  in_block         = cur_block;
+  in_block.height += clen - 1;
+  in_block.y      -= clen / 2;
 
-  col = gegl_malloc (sizeof (gfloat) * in_col.height  * nc);
-  out = gegl_malloc (sizeof (gfloat) * cur_col.height * nc);
+  block = gegl_malloc (sizeof (gfloat) * in_block.height  * lanes);
+  out   = gegl_malloc (sizeof (gfloat) * cur_block.height * lanes);
 
-  for (v = 0; v < rect->width; v++)
+  for (v = 0; v < rect->width; v += GBLUR_1D_BLOCK_WIDTH)
     {
-      cur_col.x = in_col.x = rect->x + v;
+      cur_block.x     = in_block.x     = rect->x + v;
+      cur_block.width = in_block.width = MIN (GBLUR_1D_BLOCK_WIDTH,
+                                              rect->width - v);
 
-      gegl_buffer_get (src, &in_col, 1.0, format, col, GEGL_AUTO_ROWSTRIDE, policy);
+      gegl_buffer_get (src, &in_block, 1.0, format, block,
+                       lanes * sizeof (gfloat), policy);
 
-      fir_blur_1D (col, out, cmatrix, clen, rect->height, nc);
+      fir_blur_lanes (block, out, cmatrix, clen, rect->height,
+                      cur_block.width * nc, lanes);
 
-      gegl_buffer_set (dst, &cur_col, 0, format, out, GEGL_AUTO_ROWSTRIDE);
+      gegl_buffer_set (dst, &cur_block, 0, format, out,
+                       lanes * sizeof (gfloat));
     }
 
   gegl_free (out);
-  gegl_free (col);
+  gegl_free (block);
 }
 
 
@@ -42,7 +42,7 @@ static void prepare (GeglOperation *operation)
 
 /* XXX: could be sped up by special casing op-filter behavior */
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -54,6 +54,11 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong samples,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, samples, roi, level))
+
 #include "opencl/gegl-cl.h"
 
 static gboolean
@@ -88,7 +93,7 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class = GEGL_OPERATION_CLASS (klass);
   point_filter_class = GEGL_OPERATION_POINT_FILTER_CLASS (klass);
 
-  point_filter_class->process = process;
+  point_filter_class->process = process_select ();
   point_filter_class->cl_process = cl_process;
   operation_class->prepare = prepare;
 
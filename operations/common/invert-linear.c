@@ -31,7 +31,7 @@
 
 #include "gegl-op.h"
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -55,8 +55,61 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong samples,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, samples, roi, level))
+
 #include "opencl/invert-linear.cl.h"
 
+static gboolean
+process_u8 (GeglOperation       *op,
+            void                *in_buf,
+            void                *out_buf,
+            glong                samples,
+            const GeglRectangle *roi,
+            gint                 level)
+{
+  guint8 *in  = in_buf;
+  guint8 *out = out_buf;
+
+  while (samples--)
+    {
+      out[0] = 255 - in[0];
+      out[1] = 255 - in[1];
+      out[2] = 255 - in[2];
+      out[3] = in[3];
+
+      in += 4;
+      out+= 4;
+    }
+  return TRUE;
+}
+
+static gboolean
+process_u16 (GeglOperation       *op,
+             void                *in_buf,
+             void                *out_buf,
+             glong                samples,
+             const GeglRectangle *roi,
+             gint                 level)
+{
+  guint16 *in  = in_buf;
+  guint16 *out = out_buf;
+
+  while (samples--)
+    {
+      out[0] = 65535 - in[0];
+      out[1] = 65535 - in[1];
+      out[2] = 65535 - in[2];
+      out[3] = in[3];
+
+      in += 4;
+      out+= 4;
+    }
+  return TRUE;
+}
+
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -66,7 +119,12 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class    = GEGL_OPERATION_CLASS (klass);
   point_filter_class = GEGL_OPERATION_POINT_FILTER_CLASS (klass);
 
-  point_filter_class->process  = process;
+  point_filter_class->process  = process_select ();
+
+  gegl_operation_point_filter_class_add_format (point_filter_class,
+                                                "RGBA u8", process_u8);
+  gegl_operation_point_filter_class_add_format (point_filter_class,
+                                                "RGBA u16", process_u16);
 
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:invert-linear",
@@ -77,6 +135,7 @@ gegl_op_class_init (GeglOpClass *klass)
        _("Inverts the components (except alpha), the result is the "
          "corresponding \"negative\" image."),
     "cl-source"  , invert_linear_cl_source,
+    "commutes-with-resampling", "true",
     NULL);
 }
 
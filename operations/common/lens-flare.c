@@ -507,6 +507,7 @@ gegl_op_class_init (GeglOpClass *klass)
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:lens-flare",
     "title",       _("Lens Flare"),
+    "position-dependent", "true",
     "categories",  "light",
     "license",     "GPL3+",
     "description", _("Adds a lens flare effect."),
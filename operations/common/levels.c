@@ -53,7 +53,7 @@ property_double (out_high, _("High output"), 1.0)
 /* GeglOperationPointFilter gives us a linear buffer to operate on
  * in our requested pixel format
  */
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -96,6 +96,45 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong n_pixels,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, n_pixels, roi, level))
+
+static GeglPointClassification
+classify (GeglOperation        *op,
+          const GeglPointStats *in_stats,
+          void                 *out_pixel,
+          gint                  level)
+{
+  GeglProperties *o   = GEGL_PROPERTIES (op);
+  gfloat         *out = out_pixel;
+  gfloat          in_offset  = o->in_low * 1.0;
+  gfloat          out_offset = o->out_low * 1.0;
+  gfloat          in_range   = o->in_high-o->in_low;
+  gfloat          out_range  = o->out_high-o->out_low;
+  gfloat          scale;
+  gint            c;
+
+  if (in_range == 0.0)
+    in_range = 0.00000001;
+
+  scale = out_range/in_range;
+
+  /* the default levels, or ones set back to them, change nothing */
+  if (in_offset == 0.0f && out_offset == 0.0f && scale == 1.0f)
+    return GEGL_POINT_PASSTHROUGH;
+
+  if (!in_stats->uniform)
+    return GEGL_POINT_PROCESS;
+
+  for (c=0;c<3;c++)
+    out[c] = (in_stats->min[c] - in_offset) * scale + out_offset;
+  out[3] = in_stats->min[3];
+
+  return GEGL_POINT_CONSTANT;
+}
+
 #include "opencl/gegl-cl.h"
 
 #include "opencl/levels.cl.h"
@@ -192,8 +231,9 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class    = GEGL_OPERATION_CLASS (klass);
   point_filter_class = GEGL_OPERATION_POINT_FILTER_CLASS (klass);
 
-  point_filter_class->process = process;
+  point_filter_class->process = process_select ();
   point_filter_class->cl_process = cl_process;
+  point_filter_class->classify = classify;
 
   operation_class->opencl_support = TRUE;
 
@@ -203,6 +243,7 @@ gegl_op_class_init (GeglOpClass *klass)
     "categories" , "color",
     "description", _("Remaps the intensity range of the image"),
     "reference-composition", composition,
+    "commutes-with-resampling", "true",
     NULL);
 }
 
@@ -67,7 +67,7 @@ get_bounding_box (GeglOperation *operation)
   return gegl_rectangle_infinite_plane ();
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *operation,
          void                *out_buf,
          glong                n_pixels,
@@ -119,6 +119,59 @@ process (GeglOperation       *operation,
   return  TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *operation, void *out_buf, glong n_pixels,
+   const GeglRectangle *roi, gint level),
+  (operation, out_buf, n_pixels, roi, level))
+
+/* beyond either end of the gradient the output is a flat color */
+static gboolean
+uniform (GeglOperation       *operation,
+         const GeglRectangle *roi,
+         gint                 level,
+         void                *pixel)
+{
+  GeglProperties *o = GEGL_PROPERTIES (operation);
+  gfloat          length, dx, dy, vec0, vec1;
+  gfloat          v_min, v_max;
+  gint            x, y;
+
+  dx = o->end_x - o->start_x;
+  dy = o->end_y - o->start_y;
+
+  length = dx * dx + dy * dy;
+
+  if (GEGL_FLOAT_IS_ZERO (length))
+    {
+      memset (pixel, 0, sizeof (gfloat) * 4);
+      return TRUE;
+    }
+
+  vec0 = dx / length;
+  vec1 = dy / length;
+
+  v_min = G_MAXFLOAT;
+  v_max = -G_MAXFLOAT;
+
+  for (y = roi->y; y < roi->y + roi->height; y += MAX (roi->height - 1, 1))
+    for (x = roi->x; x < roi->x + roi->width; x += MAX (roi->width - 1, 1))
+      {
+        gfloat v = vec0 * (x - o->start_x) + vec1 * (y - o->start_y);
+
+        v_min = MIN (v_min, v);
+        v_max = MAX (v_max, v);
+      }
+
+  if (v_min > 1.0f - GEGL_FLOAT_EPSILON)
+    gegl_color_get_pixel (o->start_color, babl_format ("R'G'B'A float"), pixel);
+  else if (v_max < 0.0f + GEGL_FLOAT_EPSILON)
+    gegl_color_get_pixel (o->end_color, babl_format ("R'G'B'A float"), pixel);
+  else
+    return FALSE;
+
+  return TRUE;
+}
+
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -128,7 +181,8 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class = GEGL_OPERATION_CLASS (klass);
   point_render_class = GEGL_OPERATION_POINT_RENDER_CLASS (klass);
 
-  point_render_class->process = process;
+  point_render_class->process = process_select ();
+  point_render_class->uniform = uniform;
   operation_class->get_bounding_box = get_bounding_box;
   operation_class->prepare = prepare;
   operation_class->no_cache = TRUE;
@@ -1533,14 +1533,30 @@ mantiuk06_contmap (const int                       c,
     }
 
     /* Transform to linear scale RGB */
-    _OMP (omp parallel for schedule(static))
-    for (j = 0; j < n; j++)
+    if (gegl_fast_math_enabled ())
       {
-        Y[j] = powf (10,Y[j]);
-
-        rgb[j * 4 + 0] = powf (rgb[j * 4 + 0], saturationFactor) * Y[j];
-        rgb[j * 4 + 1] = powf (rgb[j * 4 + 1], saturationFactor) * Y[j];
-        rgb[j * 4 + 2] = powf (rgb[j * 4 + 2], saturationFactor) * Y[j];
+        _OMP (omp parallel for schedule(static))
+        for (j = 0; j < n; j++)
+          {
+            /* 10^Y, as 2^(Y log2 (10)) */
+            Y[j] = gegl_fast_exp2f (Y[j] * 3.321928095f);
+
+            rgb[j * 4 + 0] = gegl_fast_powf (rgb[j * 4 + 0], saturationFactor) * Y[j];
+            rgb[j * 4 + 1] = gegl_fast_powf (rgb[j * 4 + 1], saturationFactor) * Y[j];
+            rgb[j * 4 + 2] = gegl_fast_powf (rgb[j * 4 + 2], saturationFactor) * Y[j];
+          }
+      }
+    else
+      {
+        _OMP (omp parallel for schedule(static))
+        for (j = 0; j < n; j++)
+          {
+            Y[j] = powf (10,Y[j]);
+
+            rgb[j * 4 + 0] = powf (rgb[j * 4 + 0], saturationFactor) * Y[j];
+            rgb[j * 4 + 1] = powf (rgb[j * 4 + 1], saturationFactor) * Y[j];
+            rgb[j * 4 + 2] = powf (rgb[j * 4 + 2], saturationFactor) * Y[j];
+          }
       }
   }
 
@@ -58,6 +58,42 @@ get_required_for_output (GeglOperation       *operation,
   return result;
 }
 
+typedef struct
+{
+  GeglBuffer *aux;
+  gint        level;
+  gdouble     scaling;
+} MapData;
+
+/* the map holds the displacements, in units of the scaling property */
+static void
+map_relative_coords (const GeglRectangle *roi,
+                     gdouble             *coords,
+                     GeglMatrix2         *scale,
+                     gpointer             user_data)
+{
+  MapData       *data    = user_data;
+  const gdouble  factor  = 1 << data->level;
+  const gdouble  scaling = data->scaling / factor;
+  gfloat        *map     = g_new (gfloat, 2 * roi->width * roi->height);
+  gfloat        *m       = map;
+  gint           x;
+  gint           y;
+
+  gegl_buffer_get (data->aux, roi, 1.0 / factor,
+                   babl_format_n (babl_type ("float"), 2), map,
+                   GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+  for (y = roi->y; y < roi->y + roi->height; y++)
+    for (x = roi->x; x < roi->x + roi->width; x++, m += 2)
+      {
+        *coords++ = x + m[0] * scaling;
+        *coords++ = y + m[1] * scaling;
+      }
+
+  g_free (map);
+}
+
 static gboolean
 process (GeglOperation       *operation,
          GeglBuffer          *input,
@@ -66,72 +102,19 @@ process (GeglOperation       *operation,
          const GeglRectangle *result,
          gint                 level)
 {
-  GeglProperties       *o = GEGL_PROPERTIES (operation);
-  const Babl           *format_io, *format_coords;
-  GeglSampler          *sampler;
-  GeglBufferIterator   *it;
-  gint                  index_in, index_out, index_coords;
-
-  format_io = babl_format ("RGBA float");
-  format_coords = babl_format_n (babl_type ("float"), 2);
-
-  sampler = gegl_buffer_sampler_new_at_level (input, format_io, o->sampler_type, level);
+  GeglProperties *o = GEGL_PROPERTIES (operation);
 
   if (aux != NULL)
     {
-      it = gegl_buffer_iterator_new (output, result, level, format_io,
-                                     GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-      index_out = 0;
-
-      index_coords = gegl_buffer_iterator_add (it, aux, result, level, format_coords,
-                                               GEGL_ACCESS_READ, GEGL_ABYSS_NONE);
-      index_in = gegl_buffer_iterator_add (it, input, result, level, format_io,
-                                           GEGL_ACCESS_READ, GEGL_ABYSS_NONE);
-
-      while (gegl_buffer_iterator_next (it))
-        {
-          gint        i;
-          gint        n_pixels = it->length;
-          gint        x = it->roi->x; /* initial x                   */
-          gint        y = it->roi->y; /*           and y coordinates */
-          gdouble     scaling = GEGL_PROPERTIES (operation)->scaling;
-          gfloat     *in = it->data[index_in];
-          gfloat     *out = it->data[index_out];
-          gfloat     *coords = it->data[index_coords];
-
-          for (i=0; i<n_pixels; i++)
-            {
-              /* if the coordinate asked is an exact pixel, we fetch it
-               * directly, to avoid the blur of sampling */
-              if (coords[0] == 0 && coords[1] == 0)
-                {
-                  out[0] = in[0];
-                  out[1] = in[1];
-                  out[2] = in[2];
-                  out[3] = in[3];
-                }
-              else
-                {
-                  gegl_sampler_get (sampler, x+coords[0] * scaling,
-                                             y+coords[1] * scaling,
-                                             NULL, out,
-                                             GEGL_ABYSS_NONE);
-                }
-
-              coords += 2;
-              in += 4;
-              out += 4;
-
-              /* update x and y coordinates */
-              x++;
-              if (x >= (it->roi->x + it->roi->width))
-                {
-                  x = it->roi->x;
-                  y++;
-                }
-
-            }
-        }
+      MapData data = { aux, level, o->scaling };
+
+      /* pixels that are not displaced are copied, to avoid the blur of
+       * sampling */
+      gegl_buffer_sample_coords (input, output, result, level,
+                                 babl_format ("RGBA float"),
+                                 o->sampler_type, GEGL_ABYSS_NONE,
+                                 FALSE, TRUE,
+                                 map_relative_coords, &data);
     }
   else
     {
@@ -139,8 +122,6 @@ process (GeglOperation       *operation,
                         output, result);
     }
 
-  g_object_unref (sampler);
-
   return TRUE;
 }
 
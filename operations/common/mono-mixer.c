@@ -51,7 +51,7 @@ prepare (GeglOperation *operation)
   gegl_operation_set_format (operation, "output", babl_format ("YA float"));
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *out_buf,
@@ -94,6 +94,11 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *out_buf, glong n_pixels,
+   const GeglRectangle *roi, gint level),
+  (op, in_buf, out_buf, n_pixels, roi, level))
+
 #include "opencl/mono-mixer.cl.h"
 
 static void
@@ -106,7 +111,7 @@ gegl_op_class_init (GeglOpClass *klass)
   point_filter_class = GEGL_OPERATION_POINT_FILTER_CLASS (klass);
 
   operation_class->prepare    = prepare;
-  point_filter_class->process = process;
+  point_filter_class->process = process_select ();
 
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:mono-mixer",
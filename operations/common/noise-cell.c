@@ -370,7 +370,6 @@ process (GeglOperation       *operation,
          const GeglRectangle *roi,
          gint                 level)
 {
-  GeglBufferIterator *iter;
   const Babl         *out_format = gegl_operation_get_format (operation,
                                                               "output");
 
@@ -403,25 +402,23 @@ process (GeglOperation       *operation,
         return TRUE;
     }
 
-  iter = gegl_buffer_iterator_new (out_buf, roi, level, out_format,
-                                   GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-
-  while (gegl_buffer_iterator_next (iter))
-    c_process (operation, iter->data[0], iter->length, &iter->roi[0], level);
-
-  return  TRUE;
+  return GEGL_OPERATION_SOURCE_CLASS (gegl_op_parent_class)->process (operation, out_buf,
+                                                                      roi, level);
 }
 
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
-  GeglOperationClass       *operation_class;
-  GeglOperationSourceClass *source_class;
+  GeglOperationClass            *operation_class;
+  GeglOperationSourceClass      *source_class;
+  GeglOperationPointRenderClass *point_render_class;
 
   operation_class = GEGL_OPERATION_CLASS (klass);
   source_class = GEGL_OPERATION_SOURCE_CLASS (klass);
+  point_render_class = GEGL_OPERATION_POINT_RENDER_CLASS (klass);
 
   source_class->process = process;
+  point_render_class->process = c_process;
   operation_class->get_bounding_box = get_bounding_box;
   operation_class->prepare = prepare;
   operation_class->opencl_support = TRUE;
@@ -190,6 +190,7 @@ gegl_op_class_init (GeglOpClass *klass)
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:noise-cie-lch",
     "title",       _("Add CIE Lch Noise"),
+    "position-dependent", "true",
     "categories",  "noise",
     "description", _("Randomize lightness, chroma and hue independently"),
     NULL);
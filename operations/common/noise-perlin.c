@@ -50,6 +50,13 @@ static void
 prepare (GeglOperation *operation)
 {
   gegl_operation_set_format (operation, "output", babl_format ("Y float"));
+
+  /* set the tables up before process runs on several threads at once */
+  if (start)
+    {
+      start = 0;
+      perlin_init ();
+    }
 }
 
 static GeglRectangle
@@ -297,25 +297,6 @@ c_process (GeglOperation       *operation,
   return TRUE;
 }
 
-static gboolean
-process (GeglOperation       *operation,
-         GeglBuffer          *out_buf,
-         const GeglRectangle *roi,
-         gint                 level)
-{
-  GeglBufferIterator *iter;
-  const Babl         *format = gegl_operation_get_format (operation,
-                                                          "output");
-
-  iter = gegl_buffer_iterator_new (out_buf, roi, level, format,
-                                   GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-
-  while (gegl_buffer_iterator_next (iter))
-    c_process (operation, iter->data[0], iter->length, &iter->roi[0], level);
-
-  return  TRUE;
-}
-
 static GeglRectangle
 get_bounding_box (GeglOperation *operation)
 {
@@ -325,17 +306,17 @@ get_bounding_box (GeglOperation *operation)
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
-  GObjectClass             *object_class;
-  GeglOperationClass       *operation_class;
-  GeglOperationSourceClass *source_class;
+  GObjectClass                  *object_class;
+  GeglOperationClass            *operation_class;
+  GeglOperationPointRenderClass *point_render_class;
 
-  object_class    = G_OBJECT_CLASS (klass);
-  operation_class = GEGL_OPERATION_CLASS (klass);
-  source_class = GEGL_OPERATION_SOURCE_CLASS (klass);
+  object_class       = G_OBJECT_CLASS (klass);
+  operation_class    = GEGL_OPERATION_CLASS (klass);
+  point_render_class = GEGL_OPERATION_POINT_RENDER_CLASS (klass);
 
   object_class->finalize = finalize;
 
-  source_class->process = process;
+  point_render_class->process = c_process;
   operation_class->get_bounding_box = get_bounding_box;
   operation_class->prepare = prepare;
   operation_class->opencl_support = FALSE;
@@ -85,7 +85,7 @@ prepare (GeglOperation *self)
   return;
 }
 
-static void
+static GEGL_CPU_ACCEL_INLINE void
 process_RaGaBaAfloat (GeglOperation       *op,
                       void                *in_buf,
                       void                *aux_buf,
@@ -134,7 +134,7 @@ process_RaGaBaAfloat (GeglOperation       *op,
       }
 }
 
-static void
+static GEGL_CPU_ACCEL_INLINE void
 process_RGBAfloat (GeglOperation       *op,
                    void                *in_buf,
                    void                *aux_buf,
@@ -186,7 +186,7 @@ process_RGBAfloat (GeglOperation       *op,
       }
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *aux_buf,
@@ -203,6 +203,11 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *aux_buf, void *out_buf,
+   glong samples, const GeglRectangle *roi, gint level),
+  (op, in_buf, aux_buf, out_buf, samples, roi, level))
+
 #include "opencl/gegl-cl.h"
 
 #include "opencl/opacity.cl.h"
@@ -254,7 +259,16 @@ error:
   return TRUE;
 }
 
-/* Fast path when opacity is a no-op
+/* Lets the graph pass the input through when opacity is a no-op
+ */
+static gboolean
+is_operation_a_nop (GeglOperation *operation)
+{
+  return GEGL_PROPERTIES (operation)->value == 1.0 &&
+         !gegl_operation_get_source_node (operation, "aux");
+}
+
+/* Fast path when opacity is a no-op for the data at hand
  */
 static gboolean operation_process (GeglOperation        *operation,
                                    GeglOperationContext *context,
@@ -295,7 +309,8 @@ gegl_op_class_init (GeglOpClass *klass)
 
   operation_class->prepare = prepare;
   operation_class->process = operation_process;
-  point_composer_class->process = process;
+  operation_class->is_operation_a_nop = is_operation_a_nop;
+  point_composer_class->process = process_select ();
   point_composer_class->cl_process = cl_process;
 
   operation_class->opencl_support = TRUE;
@@ -48,7 +48,7 @@ static void prepare (GeglOperation *operation)
   gegl_operation_set_format (operation, "output", format);
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *aux_buf,
@@ -78,6 +78,43 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *aux_buf, void *out_buf,
+   glong n_pixels, const GeglRectangle *roi, gint level),
+  (op, in_buf, aux_buf, out_buf, n_pixels, roi, level))
+
+static GeglPointClassification
+classify (GeglOperation        *op,
+          const GeglPointStats *in_stats,
+          const GeglPointStats *aux_stats,
+          void                 *out_pixel,
+          gint                  level)
+{
+  gint c;
+
+  if (!aux_stats)
+    return GEGL_POINT_PASSTHROUGH;
+
+  /* the empty parts of a layer leave what is below untouched */
+  if (aux_stats->uniform)
+    {
+      for (c = 0; c < 4; c++)
+        if (aux_stats->min[c] != 0.0f)
+          break;
+      if (c == 4)
+        return GEGL_POINT_PASSTHROUGH;
+
+      /* and its opaque parts cover it */
+      if (aux_stats->min[3] == 1.0f)
+        {
+          memcpy (out_pixel, aux_stats->min, sizeof (gfloat) * 4);
+          return GEGL_POINT_CONSTANT;
+        }
+    }
+
+  return GEGL_POINT_PROCESS;
+}
+
 #include "opencl/svg-src-over.cl.h"
 
 static gboolean
@@ -174,7 +211,8 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class->process = operation_process;
 
   point_composer_class->cl_process = cl_process;
-  point_composer_class->process    = process;
+  point_composer_class->process    = process_select ();
+  point_composer_class->classify   = classify;
 
   gegl_operation_class_set_keys (operation_class,
     "name"       , "svg:src-over",
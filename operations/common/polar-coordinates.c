@@ -313,73 +313,69 @@ get_effective_area (GeglOperation *operation)
   return result;
 }
 
-static gboolean
-process (GeglOperation       *operation,
-         GeglBuffer          *input,
-         GeglBuffer          *output,
-         const GeglRectangle *result,
-         gint                 level)
+typedef struct
 {
-  GeglProperties          *o            = GEGL_PROPERTIES (operation);
-  GeglRectangle            boundary     = get_effective_area (operation);
-  const Babl              *format       = babl_format ("RGBA float");
-  GeglSampler             *sampler      = gegl_buffer_sampler_new_at_level (
-                                    input, format, GEGL_SAMPLER_NOHALO,
-                                    level);
-
-  gint      x,y;
-  gfloat   *src_buf, *dst_buf;
-  gfloat    dest[4];
-  gint      i, offset = 0;
-  gboolean  inside;
-  gdouble   px, py;
+  GeglProperties *o;
+  GeglRectangle   boundary;
+} PolarData;
 
-  GeglMatrix2  scale;        /* a matrix indicating scaling factors around the
-                                current center pixel.
-                             */
-
-  src_buf = g_new0 (gfloat, result->width * result->height * 4);
-  dst_buf = g_new0 (gfloat, result->width * result->height * 4);
-
-  gegl_buffer_get (input, result, 1.0, format, src_buf, GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
-
-  if (o->middle)
-    {
-      o->pole_x = boundary.width / 2;
-      o->pole_y = boundary.height / 2;
-    }
-
-  for (y = result->y; y < result->y + result->height; y++)
-    for (x = result->x; x < result->x + result->width; x++)
+static void
+polar_coords (const GeglRectangle *roi,
+              gdouble             *coords,
+              GeglMatrix2         *scale,
+              gpointer             user_data)
+{
+  PolarData      *data = user_data;
+  GeglProperties *o    = data->o;
+  gint            x,y;
+  gboolean        inside;
+  gdouble         px, py;
+
+  for (y = roi->y; y < roi->y + roi->height; y++)
+    for (x = roi->x; x < roi->x + roi->width; x++)
       {
 #define gegl_unmap(u,v,ud,vd) {                                         \
           gdouble rx = 0.0, ry = 0.0;                                   \
           inside = calc_undistorted_coords ((gdouble)x, (gdouble)y,     \
-                                            &rx, &ry, o, boundary);     \
+                                            &rx, &ry, o, data->boundary); \
           ud = rx;                                                      \
           vd = ry;                                                      \
         }
-        gegl_sampler_compute_scale (scale, x, y);
+        gegl_sampler_compute_scale (scale[0], x, y);
         gegl_unmap(x,y,px,py);
 #undef gegl_unmap
 
-        if (inside)
-          gegl_sampler_get (sampler, px, py, &scale, dest,
-                            GEGL_ABYSS_NONE);
-        else
-          for (i=0; i<4; i++)
-            dest[i] = 0.0;
-
-        for (i=0; i<4; i++)
-          dst_buf[offset++] = dest[i];
+        /* points outside the mapping come out transparent */
+        *coords++ = inside ? px : NAN;
+        *coords++ = inside ? py : NAN;
+        scale++;
       }
+}
 
-  gegl_buffer_set (output, result, 0, format, dst_buf, GEGL_AUTO_ROWSTRIDE);
+static gboolean
+process (GeglOperation       *operation,
+         GeglBuffer          *input,
+         GeglBuffer          *output,
+         const GeglRectangle *result,
+         gint                 level)
+{
+  GeglProperties          *o            = GEGL_PROPERTIES (operation);
+  PolarData                data;
+
+  data.o        = o;
+  data.boundary = get_effective_area (operation);
 
-  g_free (src_buf);
-  g_free (dst_buf);
+  if (o->middle)
+    {
+      o->pole_x = data.boundary.width / 2;
+      o->pole_y = data.boundary.height / 2;
+    }
 
-  g_object_unref (sampler);
+  gegl_buffer_sample_coords (input, output, result, level,
+                             babl_format ("RGBA float"),
+                             GEGL_SAMPLER_NOHALO, GEGL_ABYSS_NONE,
+                             TRUE, FALSE,
+                             polar_coords, &data);
 
   return  TRUE;
 }
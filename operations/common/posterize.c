@@ -39,12 +39,13 @@ property_int  (levels, _("Levels"), 8)
 #endif
 
 
-static gboolean process (GeglOperation       *operation,
-                         void                *in_buf,
-                         void                *out_buf,
-                         glong                samples,
-                         const GeglRectangle *roi,
-                         gint                 level)
+static GEGL_CPU_ACCEL_INLINE gboolean
+process (GeglOperation       *operation,
+         void                *in_buf,
+         void                *out_buf,
+         glong                samples,
+         const GeglRectangle *roi,
+         gint                 level)
 {
   GeglProperties *o      = GEGL_PROPERTIES (operation);
   gfloat     *src    = in_buf;
@@ -65,6 +66,21 @@ static gboolean process (GeglOperation       *operation,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *operation, void *in_buf, void *out_buf,
+   glong samples, const GeglRectangle *roi, gint level),
+  (operation, in_buf, out_buf, samples, roi, level))
+
+static gfloat
+transfer (gfloat   value,
+          gpointer operation)
+{
+  GeglProperties *o      = GEGL_PROPERTIES (operation);
+  gfloat          levels = o->levels;
+
+  return RINT (value * levels) / levels;
+}
+
 #include "opencl/gegl-cl.h"
 #include "opencl/posterize.cl.h"
 
@@ -124,9 +140,12 @@ gegl_op_class_init (GeglOpClass *klass)
   point_filter_class = GEGL_OPERATION_POINT_FILTER_CLASS (klass);
 
   operation_class->opencl_support = TRUE;
-  point_filter_class->process     = process;
+  point_filter_class->process     = process_select ();
   point_filter_class->cl_process  = cl_process;
 
+  gegl_operation_point_filter_class_set_transfer (point_filter_class,
+                                                  "RGBA float", TRUE, transfer);
+
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:posterize",
     "title",       _("Posterize"),
@@ -61,7 +61,7 @@ dist (gfloat x1, gfloat y1, gfloat x2, gfloat y2)
   return sqrtf (dx * dx + dy * dy);
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *operation,
          void                *out_buf,
          glong                n_pixels,
@@ -105,6 +105,41 @@ process (GeglOperation       *operation,
   return  TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *operation, void *out_buf, glong n_pixels,
+   const GeglRectangle *roi, gint level),
+  (operation, out_buf, n_pixels, roi, level))
+
+/* outside the circle the output is a flat color */
+static gboolean
+uniform (GeglOperation       *operation,
+         const GeglRectangle *roi,
+         gint                 level,
+         void                *pixel)
+{
+  GeglProperties *o      = GEGL_PROPERTIES (operation);
+  gfloat          length = dist (o->start_x, o->start_y, o->end_x, o->end_y);
+  gfloat          nearest_x, nearest_y;
+
+  if (GEGL_FLOAT_IS_ZERO (length))
+    {
+      gegl_color_get_pixel (o->end_color, babl_format ("R'G'B'A float"), pixel);
+      return TRUE;
+    }
+
+  nearest_x = CLAMP (o->start_x, roi->x, roi->x + roi->width - 1);
+  nearest_y = CLAMP (o->start_y, roi->y, roi->y + roi->height - 1);
+
+  if (dist (nearest_x, nearest_y, o->start_x, o->start_y) / length >
+      1.0f - GEGL_FLOAT_EPSILON)
+    {
+      gegl_color_get_pixel (o->start_color, babl_format ("R'G'B'A float"), pixel);
+      return TRUE;
+    }
+
+  return FALSE;
+}
+
 
 static void
 gegl_op_class_init (GeglOpClass *klass)
@@ -115,7 +150,8 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class    = GEGL_OPERATION_CLASS (klass);
   point_render_class = GEGL_OPERATION_POINT_RENDER_CLASS (klass);
 
-  point_render_class->process       = process;
+  point_render_class->process       = process_select ();
+  point_render_class->uniform       = uniform;
   operation_class->get_bounding_box = get_bounding_box;
   operation_class->prepare          = prepare;
   operation_class->no_cache         = TRUE;
@@ -101,6 +101,29 @@ process (GeglOperation       *operation,
   return TRUE;
 }
 
+static GeglPointClassification
+classify (GeglOperation        *operation,
+          const GeglPointStats *in_stats,
+          void                 *out_pixel,
+          gint                  level)
+{
+  GeglProperties *o = GEGL_PROPERTIES (operation);
+
+  /* the same test as red_eye_reduction() on the extremes of the chunk,
+   * when even its reddest pixel fails it every pixel is left alone
+   */
+  gfloat max_red            = in_stats->max[0] * RED_FACTOR;
+  gfloat min_green          = in_stats->min[1] * GREEN_FACTOR;
+  gfloat min_blue           = in_stats->min[2] * BLUE_FACTOR;
+  gfloat adjusted_threshold = (o->threshold - 0.4) * 2;
+
+  if (max_red < min_green - adjusted_threshold ||
+      max_red < min_blue  - adjusted_threshold)
+    return GEGL_POINT_PASSTHROUGH;
+
+  return GEGL_POINT_PROCESS;
+}
+
 #include "opencl/gegl-cl.h"
 #include "opencl/red-eye-removal.cl.h"
 
@@ -161,8 +184,11 @@ gegl_op_class_init (GeglOpClass *klass)
 
   operation_class->prepare    = prepare;
   operation_class->opencl_support = TRUE;
+  /* most tiles are left alone, keep sharing those with the input */
+  operation_class->cow_output = TRUE;
   point_filter_class->process = process;
   point_filter_class->cl_process  = cl_process;
+  point_filter_class->classify = classify;
 
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:red-eye-removal",
@@ -142,6 +142,7 @@ reinhard05_process (GeglOperation       *operation,
           normalise;
 
   gint    i, c;
+  gboolean fast;
 
   g_return_val_if_fail (operation, FALSE);
   g_return_val_if_fail (input, FALSE);
@@ -203,6 +204,8 @@ reinhard05_process (GeglOperation       *operation,
   g_return_val_if_fail (contrast >= 0.3 && contrast <= 1.0, FALSE);
 
   /* Apply the operator */
+  fast = gegl_fast_math_enabled ();
+
   for (i = 0; i < result->width * result->height; ++i)
     {
       gfloat local, global, adapt;
@@ -222,7 +225,8 @@ reinhard05_process (GeglOperation       *operation,
           adapt  = light      * local +
                    light_comp * global;
 
-          p  /= p + powf (intensity * adapt, contrast);
+          p  /= p + (fast ? gegl_fast_powf (intensity * adapt, contrast) :
+                            powf (intensity * adapt, contrast));
           *_p = p;
           reinhard05_stats_update (&normalise, p);
         }
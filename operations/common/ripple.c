@@ -83,6 +83,44 @@ prepare (GeglOperation *operation)
                              babl_format ("RGBA float"));
 }
 
+static void
+ripple_coords (const GeglRectangle *roi,
+               gdouble             *coords,
+               GeglMatrix2         *scale,
+               gpointer             user_data)
+{
+  GeglProperties *o = user_data;
+  gdouble         angle_rad = o->angle / 180.0 * G_PI;
+  gint            x;
+  gint            y;
+
+  for (y = roi->y; y < roi->y + roi->height; ++y)
+    for (x = roi->x; x < roi->x + roi->width; ++x)
+      {
+        gdouble shift;
+        gdouble lambda;
+
+        gdouble nx = x * cos (angle_rad) + y * sin (angle_rad);
+
+        switch (o->wave_type)
+          {
+            case GEGL_RIPPLE_WAVE_TYPE_SAWTOOTH:
+              lambda = div (nx,o->period).rem - o->phi * o->period;
+              if (lambda < 0)
+                lambda += o->period;
+              shift = o->amplitude * (fabs (((lambda / o->period) * 4) - 2) - 1);
+              break;
+            case GEGL_RIPPLE_WAVE_TYPE_SINE:
+            default:
+              shift = o->amplitude * sin (2.0 * G_PI * nx / o->period + 2.0 * G_PI * o->phi);
+              break;
+          }
+
+        *coords++ = x + shift * sin (angle_rad);
+        *coords++ = y + shift * cos (angle_rad);
+      }
+}
+
 static gboolean
 process (GeglOperation       *operation,
          GeglBuffer          *input,
@@ -90,64 +128,14 @@ process (GeglOperation       *operation,
          const GeglRectangle *result,
          gint                 level)
 {
-  GeglProperties         *o       = GEGL_PROPERTIES (operation);
-  GeglSampler        *sampler = gegl_buffer_sampler_new_at_level (input,
-                                                         babl_format ("RGBA float"),
-                                                         o->sampler_type,
-                                                         level);
-  GeglBufferIterator *iter;
-
-  GeglAbyssPolicy abyss = o->tileable ? GEGL_ABYSS_LOOP : GEGL_ABYSS_NONE;
-
-  iter = gegl_buffer_iterator_new (output, result, 0, babl_format ("RGBA float"),
-                                   GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-
-  while (gegl_buffer_iterator_next (iter))
-    {
-      gint x = result->x;
-      gint y = result->y;
-      gfloat *out_pixel = iter->data[0];
-
-      for (y = iter->roi[0].y; y < iter->roi[0].y + iter->roi[0].height; ++y)
-        for (x = iter->roi[0].x; x < iter->roi[0].x + iter->roi[0].width; ++x)
-          {
-            gdouble shift;
-            gdouble coordsx;
-            gdouble coordsy;
-            gdouble lambda;
-
-            gdouble angle_rad = o->angle / 180.0 * G_PI;
-            gdouble nx = x * cos (angle_rad) + y * sin (angle_rad);
-
-            switch (o->wave_type)
-              {
-                case GEGL_RIPPLE_WAVE_TYPE_SAWTOOTH:
-                  lambda = div (nx,o->period).rem - o->phi * o->period;
-                  if (lambda < 0)
-                    lambda += o->period;
-                  shift = o->amplitude * (fabs (((lambda / o->period) * 4) - 2) - 1);
-                  break;
-                case GEGL_RIPPLE_WAVE_TYPE_SINE:
-                default:
-                  shift = o->amplitude * sin (2.0 * G_PI * nx / o->period + 2.0 * G_PI * o->phi);
-                  break;
-              }
-
-            coordsx = x + shift * sin (angle_rad);
-            coordsy = y + shift * cos (angle_rad);
-
-            gegl_sampler_get (sampler,
-                              coordsx,
-                              coordsy,
-                              NULL,
-                              out_pixel,
-                              abyss);
-
-            out_pixel += 4;
-          }
-    }
-
-  g_object_unref (sampler);
+  GeglProperties  *o     = GEGL_PROPERTIES (operation);
+  GeglAbyssPolicy  abyss = o->tileable ? GEGL_ABYSS_LOOP : GEGL_ABYSS_NONE;
+
+  gegl_buffer_sample_coords (input, output, result, level,
+                             babl_format ("RGBA float"),
+                             o->sampler_type, abyss,
+                             FALSE, FALSE,
+                             ripple_coords, o);
 
   return  TRUE;
 }
@@ -49,7 +49,7 @@ static void prepare (GeglOperation *operation)
   gegl_operation_set_format (operation, "output", format);
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *operation,
          void                *in_buf,
          void                *out_buf,
@@ -93,6 +93,11 @@ process (GeglOperation       *operation,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *operation, void *in_buf, void *out_buf,
+   glong n_pixels, const GeglRectangle *roi, gint level),
+  (operation, in_buf, out_buf, n_pixels, roi, level))
+
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -103,7 +108,7 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class->prepare = prepare;
   operation_class->opencl_support = FALSE;
 
-  point_filter_class->process = process;
+  point_filter_class->process = process_select ();
 
   gegl_operation_class_set_keys (operation_class,
     "name"       , "gegl:sepia",
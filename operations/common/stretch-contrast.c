@@ -33,34 +33,70 @@ property_boolean (keep_colors, _("Keep colors"), TRUE)
 #include "gegl-op.h"
 #include <math.h>
 
+typedef struct
+{
+  gfloat min[3];
+  gfloat max[3];
+} MinMax;
+
+static void
+min_max_chunk (GeglBufferIterator *gi,
+               gpointer            state,
+               gpointer            user_data)
+{
+  MinMax *mm  = state;
+  gfloat *buf = gi->data[0];
+  gint    i, c;
+
+  for (i = 0; i < gi->length; i++)
+    {
+      for (c = 0; c < 3; c++)
+        {
+          mm->min[c] = MIN (buf [i * 3 + c], mm->min[c]);
+          mm->max[c] = MAX (buf [i * 3 + c], mm->max[c]);
+        }
+    }
+}
+
+static void
+min_max_merge (gpointer result,
+               gpointer state,
+               gpointer user_data)
+{
+  MinMax *mm    = result;
+  MinMax *other = state;
+  gint    c;
+
+  for (c = 0; c < 3; c++)
+    {
+      mm->min[c] = MIN (other->min[c], mm->min[c]);
+      mm->max[c] = MAX (other->max[c], mm->max[c]);
+    }
+}
+
 static void
 buffer_get_min_max (GeglBuffer *buffer,
                     gfloat     *min,
                     gfloat     *max)
 {
   GeglBufferIterator *gi;
+  MinMax              mm;
   gint c;
   gi = gegl_buffer_iterator_new (buffer, NULL, 0, babl_format ("RGB float"),
                                  GEGL_ACCESS_READ, GEGL_ABYSS_NONE);
   for (c = 0; c < 3; c++)
     {
-      min[c] =  G_MAXFLOAT;
-      max[c] = -G_MAXFLOAT;
+      mm.min[c] =  G_MAXFLOAT;
+      mm.max[c] = -G_MAXFLOAT;
     }
 
-  while (gegl_buffer_iterator_next (gi))
-    {
-      gfloat *buf = gi->data[0];
+  gegl_buffer_iterator_foreach (gi, min_max_chunk, &mm, sizeof (mm),
+                                min_max_merge, NULL);
 
-      gint i;
-      for (i = 0; i < gi->length; i++)
-        {
-          for (c = 0; c < 3; c++)
-            {
-              min[c] = MIN (buf [i * 3 + c], min[c]);
-              max[c] = MAX (buf [i * 3 + c], max[c]);
-            }
-        }
+  for (c = 0; c < 3; c++)
+    {
+      min[c] = mm.min[c];
+      max[c] = mm.max[c];
     }
 }
 
@@ -338,6 +338,7 @@ gegl_op_class_init (GeglOpClass *klass)
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:supernova",
     "title",       _("Supernova"),
+    "position-dependent", "true",
     "categories",  "light",
     "license",     "GPL3+",
     "description", _("This plug-in produces an effect like a supernova "
@@ -41,7 +41,7 @@ static void prepare (GeglOperation *operation)
   gegl_operation_set_format (operation, "output", babl_format ("YA float"));
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *aux_buf,
@@ -91,6 +91,49 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *aux_buf, void *out_buf,
+   glong n_pixels, const GeglRectangle *roi, gint level),
+  (op, in_buf, aux_buf, out_buf, n_pixels, roi, level))
+
+static GeglPointClassification
+classify (GeglOperation        *op,
+          const GeglPointStats *in_stats,
+          const GeglPointStats *aux_stats,
+          void                 *out_pixel,
+          gint                  level)
+{
+  gfloat *out = out_pixel;
+  gfloat  low, high;
+
+  if (!in_stats || in_stats->min[1] != in_stats->max[1])
+    return GEGL_POINT_PROCESS;
+
+  if (aux_stats)
+    {
+      low  = aux_stats->min[0];
+      high = aux_stats->max[0];
+    }
+  else
+    {
+      low = high = GEGL_PROPERTIES (op)->value;
+    }
+
+  /* with all of the chunk on one side of the threshold, and a single
+   * alpha, the output is a single pixel
+   */
+  if (in_stats->min[0] >= high)
+    out[0] = 1.0;
+  else if (in_stats->max[0] < low)
+    out[0] = 0.0;
+  else
+    return GEGL_POINT_PROCESS;
+
+  out[1] = in_stats->min[1];
+
+  return GEGL_POINT_CONSTANT;
+}
+
 #include "opencl/threshold.cl.h"
 
 static const gchar *composition =
@@ -117,7 +160,8 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class = GEGL_OPERATION_CLASS (klass);
   point_composer_class = GEGL_OPERATION_POINT_COMPOSER_CLASS (klass);
 
-  point_composer_class->process = process;
+  point_composer_class->process = process_select ();
+  point_composer_class->classify = classify;
   operation_class->prepare = prepare;
 
   gegl_operation_class_set_keys (operation_class,
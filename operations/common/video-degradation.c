@@ -316,6 +316,7 @@ gegl_op_class_init (GeglOpClass *klass)
   gegl_operation_class_set_keys (operation_class,
     "name",        "gegl:video-degradation",
     "title",       _("Video Degradation"),
+    "position-dependent", "true",
     "categories",  "distort",
     "license",     "GPL3+",
     "description", _("This function simulates the degradation of "
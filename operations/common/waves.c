@@ -78,6 +78,55 @@ prepare (GeglOperation *operation)
   gegl_operation_set_format (operation, "output", babl_format ("RGBA float"));
 }
 
+typedef struct
+{
+  GeglProperties *o;
+  gdouble         px_x;
+  gdouble         px_y;
+  gdouble         scalex;
+  gdouble         scaley;
+} WavesData;
+
+static void
+waves_coords (const GeglRectangle *roi,
+              gdouble             *coords,
+              GeglMatrix2         *scale,
+              gpointer             user_data)
+{
+  WavesData      *data = user_data;
+  GeglProperties *o    = data->o;
+  gint            x;
+  gint            y;
+
+  for (y = roi->y; y < roi->y + roi->height; ++y)
+    for (x = roi->x; x < roi->x + roi->width; ++x)
+      {
+        gdouble radius;
+        gdouble shift;
+        gdouble dx;
+        gdouble dy;
+        gdouble ux;
+        gdouble uy;
+
+        dx = (x - data->px_x) * data->scalex;
+        dy = (y - data->px_y) * data->scaley;
+
+        if (!dx && !dy)
+          radius = 0.000001;
+        else
+          radius = sqrt (dx * dx + dy * dy);
+
+        shift = o->amplitude * sin (2.0 * G_PI * radius / o->period +
+                                    2.0 * G_PI * o->phi);
+
+        ux = dx / radius;
+        uy = dy / radius;
+
+        *coords++ = x + (shift + ux) / data->scalex;
+        *coords++ = y + (shift + uy) / data->scaley;
+      }
+}
+
 static gboolean
 process (GeglOperation       *operation,
          GeglBuffer          *input,
@@ -85,83 +134,37 @@ process (GeglOperation       *operation,
          const GeglRectangle *result,
          gint                 level)
 {
-  GeglProperties     *o       = GEGL_PROPERTIES (operation);
-  GeglSampler        *sampler = gegl_buffer_sampler_new_at_level (input,
-                                                         babl_format ("RGBA float"),
-                                                         o->sampler_type,
-                                                         level);
+  GeglProperties     *o         = GEGL_PROPERTIES (operation);
   GeglRectangle      *in_extent = gegl_operation_source_get_bounding_box (operation, "input");
-  GeglBufferIterator *iter;
+  WavesData           data;
 
   GeglAbyssPolicy abyss = o->clamp ? GEGL_ABYSS_CLAMP : GEGL_ABYSS_NONE;
 
-  gdouble px_x = gegl_coordinate_relative_to_pixel (o->x, in_extent->width);
-  gdouble px_y = gegl_coordinate_relative_to_pixel (o->y, in_extent->height);
-
-  gdouble scalex;
-  gdouble scaley;
+  data.o    = o;
+  data.px_x = gegl_coordinate_relative_to_pixel (o->x, in_extent->width);
+  data.px_y = gegl_coordinate_relative_to_pixel (o->y, in_extent->height);
 
   if (o->aspect > 1.0)
     {
-      scalex = 1.0;
-      scaley = o->aspect;
+      data.scalex = 1.0;
+      data.scaley = o->aspect;
     }
   else if (o->aspect < 1.0)
     {
-      scalex = 1.0 / o->aspect;
-      scaley = 1.0;
+      data.scalex = 1.0 / o->aspect;
+      data.scaley = 1.0;
     }
   else
     {
-      scalex = 1.0;
-      scaley = 1.0;
-    }
-
-  iter = gegl_buffer_iterator_new (output, result, 0, babl_format ("RGBA float"),
-                                   GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
-
-  while (gegl_buffer_iterator_next (iter))
-    {
-      gint x = result->x;
-      gint y = result->y;
-      gfloat *out_pixel = iter->data[0];
-
-      for (y = iter->roi[0].y; y < iter->roi[0].y + iter->roi[0].height; ++y)
-        for (x = iter->roi[0].x; x < iter->roi[0].x + iter->roi[0].width; ++x)
-          {
-            gdouble radius;
-            gdouble shift;
-            gdouble dx;
-            gdouble dy;
-            gdouble ux;
-            gdouble uy;
-
-            dx = (x - px_x) * scalex;
-            dy = (y - px_y) * scaley;
-
-            if (!dx && !dy)
-              radius = 0.000001;
-            else
-              radius = sqrt (dx * dx + dy * dy);
-
-            shift = o->amplitude * sin (2.0 * G_PI * radius / o->period +
-                                        2.0 * G_PI * o->phi);
-
-            ux = dx / radius;
-            uy = dy / radius;
-
-            gegl_sampler_get (sampler,
-                              x + (shift + ux) / scalex,
-                              y + (shift + uy) / scaley,
-                              NULL,
-                              out_pixel,
-                              abyss);
-
-            out_pixel += 4;
-          }
+      data.scalex = 1.0;
+      data.scaley = 1.0;
     }
 
-  g_object_unref (sampler);
+  gegl_buffer_sample_coords (input, output, result, level,
+                             babl_format ("RGBA float"),
+                             o->sampler_type, abyss,
+                             FALSE, FALSE,
+                             waves_coords, &data);
 
   return TRUE;
 }
@@ -100,7 +100,7 @@ error:
   return TRUE;
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *aux_buf,
@@ -166,6 +166,11 @@ process (GeglOperation       *op,
   return TRUE;
 }
 
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *aux_buf, void *out_buf,
+   glong n_pixels, const GeglRectangle *roi, gint level),
+  (op, in_buf, aux_buf, out_buf, n_pixels, roi, level))
+
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -175,7 +180,7 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class      = GEGL_OPERATION_CLASS (klass);
   point_composer_class = GEGL_OPERATION_POINT_COMPOSER_CLASS (klass);
 
-  point_composer_class->process    = process;
+  point_composer_class->process    = process_select ();
   point_composer_class->cl_process = cl_process;
   operation_class->prepare         = prepare;
   operation_class->opencl_support  = TRUE;
@@ -131,62 +131,79 @@ calc_undistorted_coords (gdouble  wx,
   return inside;
 }
 
-/* Apply the actual transform */
+typedef struct
+{
+  gdouble whirl;
+  gdouble pinch;
+  gdouble radius;
+  gdouble cen_x;
+  gdouble cen_y;
+  gdouble scale_x;
+  gdouble scale_y;
+} WhirlPinch;
 
 static void
-apply_whirl_pinch (gdouble              whirl,
-                   gdouble              pinch,
-                   gdouble              radius,
-                   gdouble              cen_x,
-                   gdouble              cen_y,
-                   const Babl          *format,
-                   GeglBuffer          *src,
-                   GeglRectangle       *in_boundary,
-                   GeglBuffer          *dst,
-                   GeglRectangle       *boundary,
-                   const GeglRectangle *roi,
-                   gint                 level)
+whirl_pinch_coords (const GeglRectangle *roi,
+                    gdouble             *coords,
+                    GeglMatrix2         *scale,
+                    gpointer             user_data)
 {
-  gfloat *dst_buf;
-  gint row, col;
-  gdouble scale_x, scale_y;
-  gdouble cx, cy;
-  GeglSampler *sampler;
-
-  /* Get buffer in which to place dst pixels. */
-  dst_buf = g_new0 (gfloat, roi->width * roi->height * 4);
-
-  whirl = whirl * G_PI / 180;
-
-  scale_x = 1.0;
-  scale_y = (gdouble) in_boundary->width / in_boundary->height;
-  sampler = gegl_buffer_sampler_new_at_level (src, babl_format ("RaGaBaA float"),
-                                     GEGL_SAMPLER_NOHALO, level);
+  WhirlPinch *wp = user_data;
+  gint        row, col;
+  gdouble     cx, cy;
 
   for (row = 0; row < roi->height; row++) {
     for (col = 0; col < roi->width; col++) {
-        GeglMatrix2 scale;
 #define gegl_unmap(u,v,du,dv) \
         { \
           calc_undistorted_coords (u, v,\
-                                   cen_x, cen_y,\
-                                   scale_x, scale_y,\
-                                   whirl, pinch, radius,\
+                                   wp->cen_x, wp->cen_y,\
+                                   wp->scale_x, wp->scale_y,\
+                                   wp->whirl, wp->pinch, wp->radius,\
                                    &cx, &cy);\
           du=cx;dv=cy;\
         }
-        gegl_sampler_compute_scale (scale, roi->x + col, roi->y + row);
+        gegl_sampler_compute_scale (scale[0], roi->x + col, roi->y + row);
         gegl_unmap (roi->x + col, roi->y + row, cx, cy);
+#undef gegl_unmap
 
-        gegl_sampler_get (sampler, cx, cy, &scale, &dst_buf[(row * roi->width + col) * 4], GEGL_ABYSS_NONE);
+        *coords++ = cx;
+        *coords++ = cy;
+        scale++;
     } /* for */
   } /* for */
+}
 
-  /* Store dst pixels. */
-  gegl_buffer_set (dst, roi, 0, format, dst_buf, GEGL_AUTO_ROWSTRIDE);
+/* Apply the actual transform */
 
-  g_free (dst_buf);
-  g_object_unref (sampler);
+static void
+apply_whirl_pinch (gdouble              whirl,
+                   gdouble              pinch,
+                   gdouble              radius,
+                   gdouble              cen_x,
+                   gdouble              cen_y,
+                   const Babl          *format,
+                   GeglBuffer          *src,
+                   GeglRectangle       *in_boundary,
+                   GeglBuffer          *dst,
+                   GeglRectangle       *boundary,
+                   const GeglRectangle *roi,
+                   gint                 level)
+{
+  WhirlPinch wp;
+
+  wp.whirl   = whirl * G_PI / 180;
+  wp.pinch   = pinch;
+  wp.radius  = radius;
+  wp.cen_x   = cen_x;
+  wp.cen_y   = cen_y;
+  wp.scale_x = 1.0;
+  wp.scale_y = (gdouble) in_boundary->width / in_boundary->height;
+
+  gegl_buffer_sample_coords (src, dst, roi, level, format,
+                             GEGL_SAMPLER_NOHALO, GEGL_ABYSS_NONE,
+                             TRUE, FALSE,
+                             whirl_pinch_coords, &wp);
 }
 
 /*****************************************************************************/
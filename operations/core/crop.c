@@ -98,6 +98,15 @@ gegl_crop_get_bounding_box (GeglOperation *operation)
   return result;
 }
 
+static gboolean
+gegl_crop_is_operation_a_nop (GeglOperation *operation)
+{
+  GeglRectangle *in_rect = gegl_operation_source_get_bounding_box (operation, "input");
+  GeglRectangle  result  = gegl_crop_get_bounding_box (operation);
+
+  return in_rect && gegl_rectangle_equal (in_rect, &result);
+}
+
 static GeglRectangle
 gegl_crop_get_invalidated_by_change (GeglOperation       *operation,
                                      const gchar         *input_pad,
@@ -202,6 +211,7 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class->detect                    = gegl_crop_detect;
   operation_class->get_invalidated_by_change = gegl_crop_get_invalidated_by_change;
   operation_class->get_required_for_output   = gegl_crop_get_required_for_output;
+  operation_class->is_operation_a_nop        = gegl_crop_is_operation_a_nop;
 
   gegl_operation_class_set_keys (operation_class,
       "name",        "gegl:crop",
@@ -29,7 +29,8 @@ a = [
       ['subtract',  'result = input - value', 0.0],
       ['multiply',  'result = input * value', 1.0],
       ['divide',    'result = value==0.0f?0.0f:input/value', 1.0],
-      ['gamma',     'result = powf (input, value)', 1.0],
+      ['gamma',     'result = powf (input, value)', 1.0,
+                    'result = gegl_fast_powf (input, value)'],
 #     ['threshold', 'result = c>=value?1.0f:0.0f', 0.5],
 #     ['invert',    'result = 1.0-c']
     ]
@@ -47,6 +48,7 @@ a.each do
     capitalized = name.capitalize
     swapcased   = name.swapcase
     formula     = item[1]
+    fast        = item[3]
 
     file.write copyright
     file.write "
@@ -81,21 +83,24 @@ static void prepare (GeglOperation *operation)
   gegl_operation_set_format (operation, \"aux\", babl_format (\"RGB float\"));
   gegl_operation_set_format (operation, \"output\", format);
 }
-
+"
+    emit_process = lambda do |suffix, f, dispatch|
+      pad = ' ' * suffix.length
+      file.write "
 static gboolean
-process (GeglOperation       *op,
-         void                *in_buf,
-         void                *aux_buf,
-         void                *out_buf,
-         glong                n_pixels,
-         const GeglRectangle *roi,
-         gint                 level)
+process#{suffix} (GeglOperation       *op,
+         #{pad}void                *in_buf,
+         #{pad}void                *aux_buf,
+         #{pad}void                *out_buf,
+         #{pad}glong                n_pixels,
+         #{pad}const GeglRectangle *roi,
+         #{pad}gint                 level)
 {
   gfloat * GEGL_ALIGNED in = in_buf;
   gfloat * GEGL_ALIGNED out = out_buf;
   gfloat * GEGL_ALIGNED aux = aux_buf;
   gint    i;
-
+#{dispatch}
   if (aux == NULL)
     {
       gfloat value = GEGL_PROPERTIES (op)->value;
@@ -106,7 +111,7 @@ process (GeglOperation       *op,
             {
               gfloat result;
               gfloat input=in[j];
-              #{formula};
+              #{f};
               out[j]=result;
             }
           out[3]=in[3];
@@ -125,7 +130,7 @@ process (GeglOperation       *op,
               gfloat input =in[j];
               gfloat result;
               value=aux[j];
-              #{formula};
+              #{f};
               out[j]=result;
             }
           out[3]=in[3];
@@ -137,6 +142,26 @@ process (GeglOperation       *op,
 
   return TRUE;
 }
+"
+    end
+
+    if fast
+      emit_process.call('_fast', fast, '')
+      emit_process.call('', formula, "
+  if (gegl_fast_math_enabled ())
+    return process_fast (op, in_buf, aux_buf, out_buf, n_pixels, roi, level);
+")
+    else
+      emit_process.call('', formula, '')
+    end
+
+    file.write "
+static gboolean
+is_operation_a_nop (GeglOperation *operation)
+{
+  return GEGL_PROPERTIES (operation)->value == #{item[2]} &&
+         !gegl_operation_get_source_node (operation, \"aux\");
+}
 
 static void
 gegl_op_class_init (GeglOpClass *klass)
@@ -149,6 +174,7 @@ gegl_op_class_init (GeglOpClass *klass)
 
   point_composer_class->process = process;
   operation_class->prepare = prepare;
+  operation_class->is_operation_a_nop = is_operation_a_nop;
 
   gegl_operation_class_set_keys (operation_class,
   \"name\"        , \"gegl:#{name}\",
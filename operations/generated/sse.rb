@@ -0,0 +1,207 @@
+# -*- coding: utf-8 -*-
+#
+# Helpers shared by the generators for emitting SSE versions of the
+# per-channel formulas, the formulas are parsed as plain C expressions
+# over cA, cB, aA and aB and rewritten as xmmintrin.h calls operating on
+# the same channel of four pixels at a time.
+
+SSE_OPS = {
+  '+'  => '_mm_add_ps',
+  '-'  => '_mm_sub_ps',
+  '*'  => '_mm_mul_ps',
+  '/'  => '_mm_div_ps',
+  '<'  => '_mm_cmplt_ps',
+  '<=' => '_mm_cmple_ps',
+  '>'  => '_mm_cmpgt_ps',
+  '>=' => '_mm_cmpge_ps'
+}
+
+SSE_FUNCS = {
+  'MIN' => '_mm_min_ps',
+  'MAX' => '_mm_max_ps'
+}
+
+SSE_VARIABLES = ['cA', 'cB', 'aA', 'aB']
+
+# formulas using anything not understood here (ternaries, equality tests,
+# divisions that might be by zero, libm calls) stay scalar only.
+def sse_supported (formula)
+  formula.scan(/[0-9.]+f?|[A-Za-z_]+|[<>]=?|[-+*()?=,\/]/).all? do
+    |token|
+    token =~ /^[0-9.]+f?$/ ||
+    SSE_VARIABLES.include?(token) ||
+    SSE_FUNCS.has_key?(token) ||
+    ['+', '-', '*', '(', ')', ',', '<', '<=', '>', '>='].include?(token)
+  end
+end
+
+class SSEParser
+  def initialize (formula)
+    @tokens = formula.scan(/[0-9.]+f?|[A-Za-z_]+|[<>]=?|[-+*()?=,\/]/)
+  end
+
+  def parse
+    result = condition
+    raise "trailing tokens in formula" unless @tokens.empty?
+    result
+  end
+
+  private
+
+  def condition
+    left = expression
+    if ['<', '<=', '>', '>='].include?(@tokens.first)
+      op = @tokens.shift
+      left = "#{SSE_OPS[op]} (#{left}, #{expression})"
+    end
+    left
+  end
+
+  def expression
+    left = term
+    while ['+', '-'].include?(@tokens.first)
+      op = @tokens.shift
+      left = "#{SSE_OPS[op]} (#{left}, #{term})"
+    end
+    left
+  end
+
+  def term
+    left = factor
+    while ['*', '/'].include?(@tokens.first)
+      op = @tokens.shift
+      left = "#{SSE_OPS[op]} (#{left}, #{factor})"
+    end
+    left
+  end
+
+  def factor
+    token = @tokens.shift
+    if token == '('
+      result = expression
+      expect ')'
+      result
+    elsif SSE_FUNCS.has_key?(token)
+      expect '('
+      first = expression
+      expect ','
+      second = expression
+      expect ')'
+      "#{SSE_FUNCS[token]} (#{first}, #{second})"
+    elsif SSE_VARIABLES.include?(token)
+      token
+    elsif token =~ /^[0-9.]+f?$/
+      value = token.sub(/f$/, '').to_f
+      value == 0.0 ? "_mm_setzero_ps ()" : "_mm_set1_ps (#{value}f)"
+    else
+      raise "unexpected token '#{token}' in formula"
+    end
+  end
+
+  def expect (token)
+    raise "expected '#{token}' in formula" unless @tokens.shift == token
+  end
+end
+
+def sse_formula (formula)
+  SSEParser.new(formula).parse
+end
+
+# Emits a function processing n_pixels RGBA float pixels four at a time,
+# returning the number of pixels it handled; the remainder is left to the
+# scalar loop. The pixels are transposed so that every register holds the
+# same channel of four pixels, which makes the per-channel formulas map
+# directly onto vector arithmetic.
+#
+# It is inlined into process (), and so compiled again for each of the
+# instruction sets GEGL_CPU_ACCEL_DEFINE_CLONES builds process () for.
+#
+# color_body receives the name of the variable to assign and returns the
+# statements computing one colour channel from cA, cB, aA, aB and aD.
+def sse_process (alpha_formula, color_body)
+"
+#ifdef USE_SSE
+static GEGL_CPU_ACCEL_INLINE glong
+process_sse (const gfloat *in,
+             const gfloat *aux,
+             gfloat       *out,
+             glong         n_pixels)
+{
+  glong i;
+
+  for (i = 0; i + 4 <= n_pixels; i += 4)
+    {
+      __m128 b[4], a[4], d[4];
+      __m128 aA G_GNUC_UNUSED, aB G_GNUC_UNUSED, aD;
+      gint   j;
+
+      for (j = 0; j < 4; j++)
+        {
+          b[j] = _mm_loadu_ps (in + j * 4);
+          a[j] = _mm_loadu_ps (aux + j * 4);
+        }
+      _MM_TRANSPOSE4_PS (b[0], b[1], b[2], b[3]);
+      _MM_TRANSPOSE4_PS (a[0], a[1], a[2], a[3]);
+
+      aB = b[3];
+      aA = a[3];
+      aD = #{sse_formula(alpha_formula)};
+
+      for (j = 0; j < 3; j++)
+        {
+          __m128 cA G_GNUC_UNUSED, cB G_GNUC_UNUSED;
+
+          cB = b[j];
+          cA = a[j];
+#{color_body.call('d[j]')}
+        }
+      d[3] = aD;
+
+      _MM_TRANSPOSE4_PS (d[0], d[1], d[2], d[3]);
+      for (j = 0; j < 4; j++)
+        _mm_storeu_ps (out + j * 4, d[j]);
+
+      in  += 16;
+      aux += 16;
+      out += 16;
+    }
+
+  return i;
+}
+#endif
+"
+end
+
+# The call placed ahead of the scalar loop in process (). configure adds
+# -msse to the CFLAGS whenever it defines USE_SSE, so SSE is assumed by
+# the whole build and needs no check at run time; the choice between the
+# wider instruction sets is made once, by process_select ().
+def sse_dispatch (indent)
+  "
+#ifdef USE_SSE
+#{indent}{
+#{indent}  glong done = process_sse (in, aux, out, n_pixels);
+
+#{indent}  in       += done * 4;
+#{indent}  aux      += done * 4;
+#{indent}  out      += done * 4;
+#{indent}  n_pixels -= done;
+#{indent}}
+#endif
+"
+end
+
+# The clones of process () for the instruction sets distro builds can't
+# assume, placed after it; class_init installs process_select ().
+SSE_CLONES = "
+GEGL_CPU_ACCEL_DEFINE_CLONES (gboolean, process,
+  (GeglOperation *op, void *in_buf, void *aux_buf, void *out_buf,
+   glong n_pixels, const GeglRectangle *roi, gint level),
+  (op, in_buf, aux_buf, out_buf, n_pixels, roi, level))
+"
+
+SSE_INCLUDES = "
+#ifdef USE_SSE
+#include <xmmintrin.h>
+#endif
+"
@@ -1,6 +1,8 @@
 #!/usr/bin/env ruby
 # -*- coding: utf-8 -*-
 
+require_relative 'sse'
+
 copyright = '
 /* !!!! AUTOGENERATED FILE generated by svg-12-blend.rb !!!!!
  *
@@ -146,7 +148,7 @@ static gboolean operation_process (GeglOperation        *operation,
   return operation_class->process (operation, context, output_prop, result, level);
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation       *op,
          void                *in_buf,
          void                *aux_buf,
@@ -167,7 +169,7 @@ process (GeglOperation       *op,
 file_tail1 = '
   return TRUE;
 }
-
+' + SSE_CLONES + '
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -177,7 +179,7 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class      = GEGL_OPERATION_CLASS (klass);
   point_composer_class = GEGL_OPERATION_POINT_COMPOSER_CLASS (klass);
 
-  point_composer_class->process = process;
+  point_composer_class->process = process_select ();
   operation_class->process      = operation_process;
   operation_class->prepare      = prepare;
 '
@@ -212,7 +214,11 @@ a.each do
 
 #include \"gegl-op.h\"
 "
+    file.write SSE_INCLUDES
+    file.write sse_process('aA + aB - aA * aB', lambda { |dest|
+"          #{dest} = _mm_min_ps (_mm_max_ps (#{sse_formula(formula1)}, _mm_setzero_ps ()), aD);" })
     file.write file_head2
+    file.write sse_dispatch('  ')
     file.write "
   for (i = 0; i < n_pixels; i++)
     {
@@ -274,7 +280,18 @@ b.each do
 
 #include \"gegl-op.h\"
 "
+    simd = sse_supported(cond1) && sse_supported(formula1) && sse_supported(formula2)
+    if simd
+      file.write SSE_INCLUDES
+      file.write sse_process('aA + aB - aA * aB', lambda { |dest|
+"          #{dest} = _mm_or_ps (_mm_and_ps (#{sse_formula(cond1)},
+                                        #{sse_formula(formula1)}),
+                             _mm_andnot_ps (#{sse_formula(cond1)},
+                                            #{sse_formula(formula2)}));
+          #{dest} = _mm_min_ps (_mm_max_ps (#{dest}, _mm_setzero_ps ()), aD);" })
+    end
     file.write file_head2
+    file.write sse_dispatch('  ') if simd
     file.write "
   for (i = 0; i < n_pixels; i++)
     {
@@ -409,7 +426,11 @@ d.each do
 
 #include \"gegl-op.h\"
 "
+    file.write SSE_INCLUDES
+    file.write sse_process(formula2, lambda { |dest|
+"          #{dest} = _mm_min_ps (_mm_max_ps (#{sse_formula(formula1)}, _mm_setzero_ps ()), aD);" })
     file.write file_head2
+    file.write sse_dispatch('  ')
     file.write "
   for (i = 0; i < n_pixels; i++)
     {
@@ -1,6 +1,8 @@
 #!/usr/bin/env ruby
 # encoding: utf-8
 
+require_relative 'sse'
+
 copyright = '
 /* !!!! AUTOGENERATED FILE generated by svg-12-porter-duff.rb !!!!!
  *
@@ -101,7 +103,7 @@ static void prepare (GeglOperation *operation)
   gegl_operation_set_format (operation, "output", format);
 }
 
-static gboolean
+static GEGL_CPU_ACCEL_INLINE gboolean
 process (GeglOperation        *op,
          void                *in_buf,
          void                *aux_buf,
@@ -116,8 +118,7 @@ process (GeglOperation        *op,
   gfloat * GEGL_ALIGNED out = out_buf;
 '
 
-file_tail1 = '
-
+file_tail1 = SSE_CLONES + '
 static void
 gegl_op_class_init (GeglOpClass *klass)
 {
@@ -127,7 +128,7 @@ gegl_op_class_init (GeglOpClass *klass)
   operation_class      = GEGL_OPERATION_CLASS (klass);
   point_composer_class = GEGL_OPERATION_POINT_COMPOSER_CLASS (klass);
 
-  point_composer_class->process = process;
+  point_composer_class->process = process_select ();
   operation_class->prepare = prepare;
 
 '
@@ -162,6 +163,9 @@ a.each do
 
 #include \"gegl-op.h\"
 "
+    file.write SSE_INCLUDES
+    file.write sse_process(a_formula, lambda { |dest|
+"          #{dest} = #{sse_formula(c_formula)};" })
     file.write file_head2
 
     if item[3]
@@ -199,7 +203,9 @@ a.each do
     end
 
     file.write "
-    {
+    {"
+    file.write sse_dispatch('      ')
+    file.write "
       for (i = 0; i < n_pixels; i++)
         {
           gint   j;
@@ -268,11 +274,16 @@ b.each do
 
 #include \"gegl-op.h\"
 "
+    file.write SSE_INCLUDES
+    file.write sse_process(a_formula, lambda { |dest|
+"          #{dest} = #{sse_formula(c_formula)};" })
     file.write file_head2
     file.write "
   if (!aux)
     return TRUE;
-
+"
+    file.write sse_dispatch('  ')
+    file.write "
   for (i = 0; i < n_pixels; i++)
     {
       gint   j;
@@ -30,10 +30,13 @@
 #include <glib/gi18n-lib.h>
 
 #include <math.h>
+#include <string.h>
 #include <gegl.h>
 #include <gegl-plugin.h>
 
 #include "gegl-config.h"
+#include "gegl-region.h"
+#include "gegl-sampler-cubic.h"
 
 #include "transform-core.h"
 #include "module.h"
@@ -42,7 +45,8 @@ enum
 {
   PROP_ORIGIN_X = 1,
   PROP_ORIGIN_Y,
-  PROP_SAMPLER
+  PROP_SAMPLER,
+  PROP_MIPMAP
 };
 
 static void          gegl_transform_get_property                 (GObject              *object,
@@ -60,6 +64,11 @@ static gboolean      gegl_transform_is_intermediate_node         (OpTransform
 static gboolean      gegl_transform_is_composite_node            (OpTransform          *transform);
 static void          gegl_transform_get_source_matrix            (OpTransform          *transform,
                                                                   GeglMatrix3          *output);
+static void          gegl_transform_finalize                     (GObject              *object);
+static void          gegl_transform_attach                       (GeglOperation        *operation);
+static void          gegl_transform_invalidated                  (GeglNode             *node,
+                                                                  const GeglRectangle  *rect,
+                                                                  OpTransform          *transform);
 static GeglRectangle gegl_transform_get_bounding_box             (GeglOperation        *op);
 static GeglRectangle gegl_transform_get_invalidated_by_change    (GeglOperation        *operation,
                                                                   const gchar          *input_pad,
@@ -75,9 +84,11 @@ static gboolean      gegl_transform_process                      (GeglOperation
 static GeglNode     *gegl_transform_detect                       (GeglOperation        *operation,
                                                                   gint                  x,
                                                                   gint                  y);
+static gboolean      gegl_transform_is_operation_a_nop           (GeglOperation        *operation);
 
 static gboolean      gegl_matrix3_is_affine                      (GeglMatrix3          *matrix);
 static gboolean      gegl_transform_matrix3_allow_fast_translate (GeglMatrix3          *matrix);
+static gboolean      gegl_transform_matrix3_is_axis_aligned_scale (GeglMatrix3         *matrix);
 static void          gegl_transform_create_composite_matrix      (OpTransform *transform,
                                                                   GeglMatrix3 *matrix);
 
@@ -156,7 +167,9 @@ op_transform_class_init (OpTransformClass *klass)
 
   gobject_class->set_property         = gegl_transform_set_property;
   gobject_class->get_property         = gegl_transform_get_property;
+  gobject_class->finalize             = gegl_transform_finalize;
 
+  op_class->attach                    = gegl_transform_attach;
   op_class->get_invalidated_by_change =
     gegl_transform_get_invalidated_by_change;
   op_class->get_bounding_box          = gegl_transform_get_bounding_box;
@@ -164,6 +177,7 @@ op_transform_class_init (OpTransformClass *klass)
   op_class->detect                    = gegl_transform_detect;
   op_class->process                   = gegl_transform_process;
   op_class->prepare                   = gegl_transform_prepare;
+  op_class->is_operation_a_nop        = gegl_transform_is_operation_a_nop;
   op_class->no_cache                  = TRUE;
   op_class->threaded                  = TRUE;
 
@@ -195,11 +209,57 @@ op_transform_class_init (OpTransformClass *klass)
                                      gegl_sampler_type_get_type (),
                                      GEGL_SAMPLER_LINEAR,
                                      G_PARAM_CONSTRUCT | G_PARAM_READWRITE));
+  g_object_class_install_property (gobject_class, PROP_MIPMAP,
+                                   g_param_spec_boolean (
+                                     "mipmap",
+                                     _("Mipmap"),
+                                     _("Resample strong nohalo and lohalo downscales from the mipmap pyramid of the input, faster but less exact"),
+                                     FALSE,
+                                     G_PARAM_CONSTRUCT | G_PARAM_READWRITE));
 }
 
 static void
 op_transform_init (OpTransform *self)
 {
+  gint level;
+
+  g_mutex_init (&self->source_mutex);
+
+  for (level = 0; level < GEGL_TRANSFORM_CORE_SOURCE_LEVELS; level++)
+    self->source_valid[level] = gegl_region_new ();
+}
+
+static void
+gegl_transform_finalize (GObject *object)
+{
+  OpTransform *self = OP_TRANSFORM (object);
+  gint         level;
+
+  for (level = 0; level < GEGL_TRANSFORM_CORE_SOURCE_LEVELS; level++)
+    {
+      if (self->source_cache[level])
+        g_object_unref (self->source_cache[level]);
+
+      gegl_region_destroy (self->source_valid[level]);
+    }
+
+  g_mutex_clear (&self->source_mutex);
+
+  G_OBJECT_CLASS (op_transform_parent_class)->finalize (object);
+}
+
+static void
+gegl_transform_attach (GeglOperation *operation)
+{
+  GEGL_OPERATION_CLASS (op_transform_parent_class)->attach (operation);
+
+  /*
+   * Changes to the input reach us as invalidations of our own node,
+   * which is where the cached source levels are dropped.
+   */
+  g_signal_connect_object (operation->node, "invalidated",
+                           G_CALLBACK (gegl_transform_invalidated),
+                           operation, 0);
 }
 
 static void
@@ -221,6 +281,9 @@ gegl_transform_get_property (GObject    *object,
     case PROP_SAMPLER:
       g_value_set_enum (value, self->sampler);
       break;
+    case PROP_MIPMAP:
+      g_value_set_boolean (value, self->mipmap);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -246,6 +309,9 @@ gegl_transform_set_property (GObject      *object,
     case PROP_SAMPLER:
       self->sampler = g_value_get_enum (value);
       break;
+    case PROP_MIPMAP:
+      self->mipmap = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -352,18 +418,65 @@ gegl_transform_bounding_box (const gdouble *points,
   output->height = (gint) ceil ((double) max_y) - output->y;
 }
 
+/*
+ * Point filters that compute each pixel from the input pixel at the same
+ * location give the same result whether they operate before or after a
+ * transform picking the nearest input pixel. The linear and cubic
+ * samplers blend neighbouring pixels with weights summing to one, which
+ * only commutes with filters that are affine per channel, and which
+ * declare it with the "commutes-with-resampling" key. Nohalo limits its
+ * slopes and lohalo sigmoidizes before interpolating, neither is linear
+ * in the pixel values so they never commute with a filter. Chains of
+ * transforms separated by such filters are composed into a single
+ * resampling, done by the last transform, with the filters operating on
+ * the untransformed data.
+ */
 static gboolean
-gegl_transform_is_intermediate_node (OpTransform *transform)
+gegl_transform_is_commutable_node (GeglNode        *node,
+                                   GeglSamplerType  sampler)
 {
-  GeglOperation *op = GEGL_OPERATION (transform);
+  GeglOperation      *operation = gegl_node_get_gegl_operation (node);
+  GeglOperationClass *klass;
 
-  gboolean is_intermediate = TRUE;
+  if (! GEGL_IS_OPERATION_POINT_FILTER (operation))
+    return FALSE;
 
-  GeglNode **consumers = NULL;
+  klass = GEGL_OPERATION_GET_CLASS (operation);
 
-  if (0 == gegl_node_get_consumers (op->node, "output", &consumers, NULL))
+  if (! g_strcmp0 (gegl_operation_class_get_key (klass, "position-dependent"),
+                   "true"))
+    return FALSE;
+
+  if (sampler == GEGL_SAMPLER_NEAREST)
+    return TRUE;
+
+  if (sampler != GEGL_SAMPLER_LINEAR &&
+      sampler != GEGL_SAMPLER_CUBIC)
+    return FALSE;
+
+  return ! g_strcmp0 (gegl_operation_class_get_key (klass, "commutes-with-resampling"),
+                      "true");
+}
+
+/*
+ * Whether all the data flowing out of node ends up in transforms using
+ * sampler, possibly passing through commutable point filters first. The
+ * perspective transforms are not sampled in the same way as the affine
+ * ones, so across filters both ends have to be affine, affine tells
+ * whether the transform at the start of the chain is.
+ */
+static gboolean
+gegl_transform_consumers_are_transforms (GeglNode        *node,
+                                         GeglSamplerType  sampler,
+                                         gboolean         affine,
+                                         gboolean         through_filter)
+{
+  gboolean   all_transforms = TRUE;
+  GeglNode **consumers      = NULL;
+
+  if (0 == gegl_node_get_consumers (node, "output", &consumers, NULL))
     {
-      is_intermediate = FALSE;
+      all_transforms = FALSE;
     }
   else
     {
@@ -372,52 +485,109 @@ gegl_transform_is_intermediate_node (OpTransform *transform)
         {
           GeglOperation *sink = gegl_node_get_gegl_operation (consumers[i]);
 
-          if (! IS_OP_TRANSFORM (sink) || transform->sampler != OP_TRANSFORM (sink)->sampler)
+          if (IS_OP_TRANSFORM (sink) && sampler == OP_TRANSFORM (sink)->sampler)
             {
-              is_intermediate = FALSE;
-              break;
+              GeglMatrix3 matrix;
+
+              gegl_transform_create_matrix (OP_TRANSFORM (sink), &matrix);
+
+              if (! through_filter || gegl_matrix3_is_affine (&matrix))
+                continue;
             }
+          else if (affine &&
+                   gegl_transform_is_commutable_node (consumers[i], sampler) &&
+                   gegl_transform_consumers_are_transforms (consumers[i], sampler,
+                                                            affine, TRUE))
+            {
+              continue;
+            }
+
+          all_transforms = FALSE;
+          break;
         }
     }
 
   g_free (consumers);
 
-  return is_intermediate;
+  return all_transforms;
 }
 
 static gboolean
-gegl_transform_is_composite_node (OpTransform *transform)
+gegl_transform_is_intermediate_node (OpTransform *transform)
 {
   GeglOperation *op = GEGL_OPERATION (transform);
-  GeglNode *source_node;
+  GeglMatrix3    matrix;
+
+  gegl_transform_create_composite_matrix (transform, &matrix);
+
+  return gegl_transform_consumers_are_transforms (op->node, transform->sampler,
+                                                  gegl_matrix3_is_affine (&matrix),
+                                                  FALSE);
+}
+
+/*
+ * Returns the transform this transform is composed with, found upstream
+ * of its input through commutable point filters, or NULL.
+ */
+static OpTransform *
+gegl_transform_get_source_transform (OpTransform *transform)
+{
+  GeglOperation *op = GEGL_OPERATION (transform);
+  GeglNode      *source_node;
   GeglOperation *source;
+  gboolean       direct = TRUE;
 
   source_node = gegl_node_get_producer (op->node, "input", NULL);
 
+  while (source_node &&
+         gegl_transform_is_commutable_node (source_node, transform->sampler))
+    {
+      source_node = gegl_node_get_producer (source_node, "input", NULL);
+      direct = FALSE;
+    }
+
   if (!source_node)
-    return FALSE;
+    return NULL;
 
   source = gegl_node_get_gegl_operation (source_node);
 
-  return (IS_OP_TRANSFORM (source) && transform->sampler == OP_TRANSFORM (source)->sampler);
+  if (! IS_OP_TRANSFORM (source) || transform->sampler != OP_TRANSFORM (source)->sampler)
+    return NULL;
+
+  /*
+   * Through point filters, the source has to pass its input on
+   * untransformed, or it would be applied twice, which it only does for
+   * affine transforms on both ends.
+   */
+  if (! direct)
+    {
+      GeglMatrix3 matrix;
+
+      gegl_transform_create_matrix (transform, &matrix);
+
+      if (! gegl_matrix3_is_affine (&matrix) ||
+          ! gegl_transform_is_intermediate_node (OP_TRANSFORM (source)))
+        return NULL;
+    }
+
+  return OP_TRANSFORM (source);
+}
+
+static gboolean
+gegl_transform_is_composite_node (OpTransform *transform)
+{
+  return gegl_transform_get_source_transform (transform) != NULL;
 }
 
 static void
 gegl_transform_get_source_matrix (OpTransform *transform,
                                   GeglMatrix3 *output)
 {
-  GeglOperation *op = GEGL_OPERATION (transform);
-  GeglNode *source_node;
-  GeglOperation *source;
-
-  source_node = gegl_node_get_producer (op->node, "input", NULL);
-
-  g_assert (source_node);
+  OpTransform *source = gegl_transform_get_source_transform (transform);
 
-  source = gegl_node_get_gegl_operation (source_node);
-  g_assert (IS_OP_TRANSFORM (source));
+  g_assert (source);
 
-  gegl_transform_create_composite_matrix (OP_TRANSFORM (source), output);
+  gegl_transform_create_composite_matrix (source, output);
   /*gegl_matrix3_copy (output, OP_TRANSFORM (source)->matrix);*/
 }
 
@@ -701,13 +871,24 @@ gegl_transform_get_invalidated_by_change (GeglOperation       *op,
   return affected_rect;
 }
 
+/*
+ * transform_affine fills output tiles in blocks of at most
+ * GEGL_TRANSFORM_CORE_MAX_BLOCK pixels square, small enough that the
+ * input area a block maps to, GEGL_TRANSFORM_CORE_BLOCK_FOOTPRINT
+ * pixels across at most, fits the sampler's cache window together
+ * with the sampler's context.
+ */
+#define GEGL_TRANSFORM_CORE_MAX_BLOCK        64
+#define GEGL_TRANSFORM_CORE_BLOCK_FOOTPRINT  32
+
 typedef struct ThreadData
 {
-  void (*func) (GeglOperation *operation,
-                GeglBuffer  *dest,
-                GeglBuffer  *src,
-                GeglMatrix3 *matrix,
-                gint         level);
+  void (*func) (GeglOperation       *operation,
+                GeglBuffer          *dest,
+                GeglBuffer          *src,
+                GeglMatrix3         *matrix,
+                const GeglRectangle *result,
+                gint                 level);
 
 
   GeglOperation            *operation;
@@ -724,7 +905,8 @@ static void thread_process (gpointer thread_data, gpointer unused)
 {
   ThreadData *data = thread_data;
   data->func (data->operation,
-                   data->output, data->input, data->matrix, data->level);
+                   data->output, data->input, data->matrix, &data->roi,
+                   data->level);
     data->success = FALSE;
   g_atomic_int_add (data->pending, -1);
 }
@@ -742,11 +924,12 @@ static GThreadPool *thread_pool (void)
 
 
 static void
-transform_affine (GeglOperation *operation,
-                  GeglBuffer  *dest,
-                  GeglBuffer  *src,
-                  GeglMatrix3 *matrix,
-                  gint         level)
+transform_affine (GeglOperation       *operation,
+                  GeglBuffer          *dest,
+                  GeglBuffer          *src,
+                  GeglMatrix3         *matrix,
+                  const GeglRectangle *result,
+                  gint                 level)
 {
   gint         factor = 1 << level;
   OpTransform *transform = (OpTransform *) operation;
@@ -758,7 +941,7 @@ transform_affine (GeglOperation *operation,
                                          babl_format("RaGaBaA float"),
                                          level?GEGL_SAMPLER_NEAREST:transform->sampler,
                                          level);
-  GeglSamplerGetFun sampler_get_fun = gegl_sampler_get_fun (sampler);
+  GeglSamplerGetSpanFun sampler_get_span_fun = gegl_sampler_get_span_fun (sampler);
 
 
 
@@ -791,173 +974,122 @@ transform_affine (GeglOperation *operation,
   g_object_get (dest, "pixels", &dest_pixels, NULL);
 
   {
-    const GeglRectangle *dest_extent = gegl_buffer_get_extent (dest);
     GeglBufferIterator *i = gegl_buffer_iterator_new (dest,
-                                                      dest_extent,
+                                                      result,
                                                       level,
                                                       format,
                                                       GEGL_ACCESS_WRITE,
                                                       GEGL_ABYSS_NONE);
 
     /*
-     * This code uses a (novel?) trick by Nicolas Robidoux that
-     * minimizes tile buffer reallocation when affine transformations
-     * "flip" things.
-     *
-     * Explanation:
-     *
-     * Pulling a scanline (within such a square tile) back to input
-     * space (with the inverse transformation) with an arbitrary
-     * affine transformation may make the scanline go from right to
-     * left in input space even though it goes form left to right in
-     * input space. Similarly, a scanline which is below the first one
-     * in output space may be above in input space. Unfortunately,
-     * input buffer tiles are allocated with a bias: less elbow room
-     * around the context_rect (square of data needed by the sampler)
-     * is put at the left and top than at the right and bottom. (Such
-     * asymetrical elbow room is beneficial when resizing, for
-     * example, since input space is then traversed from left to right
-     * and top to bottom, which means that the left and top elbow room
-     * is not used in this situation.) When the affine transformation
-     * "flips" things, however, the elbow room is "on the wrong side",
-     * and for this reason such transformations run much much slower
-     * because many more input buffer tiles get created. One way to
-     * make things better is to traverse the output buffer tile in an
-     * appropriate chosen "reverse order" so that the "short" elbow
-     * room is "behind" instead of "ahead".
-     *
-     * Things are actually a bit more complicated than that. Here is a
-     * terse description of what's actually done, without a full
-     * explanation of why.
-     *
-     * Let's consider a scanline of the output tile which we want to
-     * fill. Pull this scanline back to input space. Assume that we
-     * are using a freshly created input tile. What direction would
-     * maximize the number of pulled back input pixels that we can fit
-     * in the input tile? Because the input tile is square and most of
-     * the extra elbow room is at the bottom and right, the "best"
-     * direction is going down the diagonal of the square,
-     * approximately from top left to bottom right of the tile.
-     *
-     * Of course, we do not have control over the actual line traced
-     * by the output scanline in input space. But what the above tells
-     * us is that if the inner product of the pulled back "scanline
-     * vector" with the vector (1,1) (which corresponds to going
-     * diagonally from top-left to bottom-right in a square tile) is
-     * negative, we are going opposite to "best". This can be
-     * rectified by filling the output scanline in reverse order: from
-     * right to left in output space.
-     *
-     * Similarly, when one computes the next scanline, one can ask
-     * whether it's the one above or below in output space which is
-     * most likely to "stick out". Repeating the same argument used
-     * for a single scanline, we see that the sign of the inner
-     * product of the inverse image of the vector that points straight
-     * down in output space with the input space vector (1,1) tells us
-     * whether we should fill the output tile from the top down or
-     * from the bottom up.
-     *
-     * Making the "best" happen requires stepping in the "right
-     * direction" both w.r.t. to data pointers and geometrical steps.
-     * In the following code, adjusting the "geometrical steps" so they
-     * go in the right direction is done by modifying the inverse
-     * Jacobian matrix to minimize the number of "geometrical
-     * quantities" floating around. It could be done leaving the
-     * Jacobian matrix alone.
-     */
-
-    /*
-     * Set the inverse_jacobian matrix (a.k.a. scale) for samplers
-     * that support it. The inverse jacobian will be "flipped" if the
-     * direction in which the ROI is filled is flipped. Flipping the
-     * inverse jacobian is not necessary for the samplers' sake, but
-     * it makes the following code shorter. Anyway, "sane" use of the
-     * inverse jacobian by a sampler only cares for its effect on
-     * sets: only the image of a centered square with sides aligned
-     * with the coordinate axes, or a centered disc, matters,
-     * irrespective of orientation ("left-hand" VS "right-hand")
-     * issues.
+     * Scanlines pulled back to input space run in arbitrary directions,
+     * so walking them across a whole output tile keeps leaving the
+     * sampler's small cache window. Instead, the output tile is filled
+     * in square blocks sized after the inverse Jacobian so that the
+     * input footprint of a block stays within
+     * GEGL_TRANSFORM_CORE_BLOCK_FOOTPRINT pixels. The footprint of each
+     * block is prefetched into the sampler in one go, after which all
+     * of its samples are served from the cache whatever the rotation.
+     * Rows within a block are sampled as spans.
      */
+    const gdouble base_u = inverse.coeff [0][0] * (gdouble) 0.5 +
+                           inverse.coeff [0][1] * (gdouble) 0.5 +
+                           inverse.coeff [0][2];
+    const gdouble base_v = inverse.coeff [1][0] * (gdouble) 0.5 +
+                           inverse.coeff [1][1] * (gdouble) 0.5 +
+                           inverse.coeff [1][2];
 
-#if 0
-    const gint flip_x = 
-      inverse.coeff [0][0] + inverse.coeff [1][0] < (gdouble) 0.
+    const gdouble step = MAX (fabs (inverse.coeff [0][0]) +
+                              fabs (inverse.coeff [0][1]),
+                              fabs (inverse.coeff [1][0]) +
+                              fabs (inverse.coeff [1][1]));
+    const gint block_size =
+      step * GEGL_TRANSFORM_CORE_MAX_BLOCK <= GEGL_TRANSFORM_CORE_BLOCK_FOOTPRINT
       ?
-      (gint) 1
+      GEGL_TRANSFORM_CORE_MAX_BLOCK
       :
-      (gint) 0;
-    const gint flip_y = 
-      inverse.coeff [0][1] + inverse.coeff [1][1] < (gdouble) 0.
-      ?
-      (gint) 1
-      :
-      (gint) 0;
-#else
-    /* XXX: not doing the flipping tricks is faster with the adaptive
-     *      sampler cache that has been added */
-    const gint flip_x = 0;
-    const gint flip_y = 0;
-#endif
+      MAX ((gint) (GEGL_TRANSFORM_CORE_BLOCK_FOOTPRINT / step), 1);
 
     /*
-     * Hoist most of what can out of the while loop:
+     * The nearest neighbour sampler reads tiles directly, and mipmap
+     * levels are sampled with it.
      */
-    const gdouble base_u = inverse.coeff [0][0] * ((gdouble) 0.5 - flip_x) +
-                           inverse.coeff [0][1] * ((gdouble) 0.5 - flip_y) +
-                           inverse.coeff [0][2];
-    const gdouble base_v = inverse.coeff [1][0] * ((gdouble) 0.5 - flip_x) +
-                           inverse.coeff [1][1] * ((gdouble) 0.5 - flip_y) +
-                           inverse.coeff [1][2];
+    const gboolean prefetch = level == 0 &&
+                              transform->sampler != GEGL_SAMPLER_NEAREST;
 
-    inverse_jacobian.coeff [0][0] =
-      flip_x ? -inverse.coeff [0][0] : inverse.coeff [0][0];
-    inverse_jacobian.coeff [1][0] =
-      flip_x ? -inverse.coeff [1][0] : inverse.coeff [1][0];
-    inverse_jacobian.coeff [0][1] =
-      flip_y ? -inverse.coeff [0][1] : inverse.coeff [0][1];
-    inverse_jacobian.coeff [1][1] =
-      flip_y ? -inverse.coeff [1][1] : inverse.coeff [1][1];
+    inverse_jacobian.coeff [0][0] = inverse.coeff [0][0];
+    inverse_jacobian.coeff [1][0] = inverse.coeff [1][0];
+    inverse_jacobian.coeff [0][1] = inverse.coeff [0][1];
+    inverse_jacobian.coeff [1][1] = inverse.coeff [1][1];
 
     while (gegl_buffer_iterator_next (i))
       {
         GeglRectangle *roi = &i->roi[0];
-        gfloat * restrict dest_ptr =
-          (gfloat *)i->data[0] +
-          (gint) 4 * ( flip_x * (roi->width  - (gint) 1) +
-                       flip_y * (roi->height - (gint) 1) * roi->width );
-
-        gdouble u_start =
-          base_u +
-          inverse.coeff [0][0] * ( roi->x + flip_x * roi->width  ) +
-          inverse.coeff [0][1] * ( roi->y + flip_y * roi->height );
-        gdouble v_start =
-          base_v +
-          inverse.coeff [1][0] * ( roi->x + flip_x * roi->width  ) +
-          inverse.coeff [1][1] * ( roi->y + flip_y * roi->height );
-
-        gint y = roi->height;
-        do {
-          gdouble u_float = u_start;
-          gdouble v_float = v_start;
-
-          gint x = roi->width;
-          do {
-            sampler_get_fun (sampler,
-                             u_float, v_float,
-                             &inverse_jacobian,
-                             dest_ptr,
-                             GEGL_ABYSS_NONE);
-            dest_ptr += (gint) 4 - (gint) 8 * flip_x;
-
-            u_float += inverse_jacobian.coeff [0][0];
-            v_float += inverse_jacobian.coeff [1][0];
-          } while (--x);
-
-          dest_ptr += (gint) 8 * (flip_x - flip_y) * roi->width;
-
-          u_start += inverse_jacobian.coeff [0][1];
-          v_start += inverse_jacobian.coeff [1][1];
-        } while (--y);
+        gint           block_x;
+        gint           block_y;
+
+        for (block_y = 0; block_y < roi->height; block_y += block_size)
+          for (block_x = 0; block_x < roi->width; block_x += block_size)
+            {
+              const gint block_width  = MIN (block_size, roi->width  - block_x);
+              const gint block_height = MIN (block_size, roi->height - block_y);
+
+              gfloat * restrict dest_ptr =
+                (gfloat *)i->data[0] +
+                (gint) 4 * (block_y * roi->width + block_x);
+
+              gdouble u_start =
+                base_u +
+                inverse.coeff [0][0] * (roi->x + block_x) +
+                inverse.coeff [0][1] * (roi->y + block_y);
+              gdouble v_start =
+                base_v +
+                inverse.coeff [1][0] * (roi->x + block_x) +
+                inverse.coeff [1][1] * (roi->y + block_y);
+
+              gint y;
+
+              if (prefetch)
+                {
+                  gdouble       corners [8];
+                  GeglRectangle footprint;
+
+                  corners [0] = u_start;
+                  corners [1] = v_start;
+                  corners [2] = corners [0] +
+                                inverse.coeff [0][0] * (block_width - (gint) 1);
+                  corners [3] = corners [1] +
+                                inverse.coeff [1][0] * (block_width - (gint) 1);
+                  corners [4] = corners [2] +
+                                inverse.coeff [0][1] * (block_height - (gint) 1);
+                  corners [5] = corners [3] +
+                                inverse.coeff [1][1] * (block_height - (gint) 1);
+                  corners [6] = corners [0] +
+                                inverse.coeff [0][1] * (block_height - (gint) 1);
+                  corners [7] = corners [1] +
+                                inverse.coeff [1][1] * (block_height - (gint) 1);
+
+                  gegl_transform_bounding_box (corners, 4, &footprint);
+                  gegl_sampler_prefetch (sampler, &footprint, GEGL_ABYSS_NONE);
+                }
+
+              for (y = 0; y < block_height; y++)
+                {
+                  sampler_get_span_fun (sampler,
+                                        u_start, v_start,
+                                        inverse.coeff [0][0],
+                                        inverse.coeff [1][0],
+                                        &inverse_jacobian,
+                                        dest_ptr,
+                                        block_width,
+                                        GEGL_ABYSS_NONE);
+
+                  dest_ptr += (gint) 4 * roi->width;
+
+                  u_start += inverse.coeff [0][1];
+                  v_start += inverse.coeff [1][1];
+                }
+            }
       }
   }
 
@@ -965,17 +1097,17 @@ transform_affine (GeglOperation *operation,
 }
 
 static void
-transform_generic (GeglOperation *operation,
-                   GeglBuffer  *dest,
-                   GeglBuffer  *src,
-                   GeglMatrix3 *matrix,
-                   gint         level)
+transform_generic (GeglOperation       *operation,
+                   GeglBuffer          *dest,
+                   GeglBuffer          *src,
+                   GeglMatrix3         *matrix,
+                   const GeglRectangle *result,
+                   gint                 level)
 {
   OpTransform *transform = (OpTransform *) operation;
   const Babl          *format = babl_format ("RaGaBaA float");
   gint                 factor = 1 << level;
   GeglBufferIterator  *i;
-  const GeglRectangle *dest_extent;
   GeglMatrix3          inverse;
   gint                 dest_pixels;
   GeglSampler *sampler = gegl_buffer_sampler_new_at_level (src,
@@ -986,13 +1118,12 @@ transform_generic (GeglOperation *operation,
   GeglSamplerGetFun sampler_get_fun = gegl_sampler_get_fun (sampler);
 
   g_object_get (dest, "pixels", &dest_pixels, NULL);
-  dest_extent = gegl_buffer_get_extent (dest);
 
   /*
    * Construct an output tile iterator.
    */
   i = gegl_buffer_iterator_new (dest,
-                                dest_extent,
+                                result,
                                 level,
                                 format,
                                 GEGL_ACCESS_WRITE,
@@ -1147,6 +1278,419 @@ transform_generic (GeglOperation *operation,
   g_object_unref (sampler);
 }
 
+/*
+ * Incremental evaluation of perspective transforms.
+ *
+ * Along an output scanline the homogeneous source coordinates (u, v, w)
+ * step by constants, so the projected coordinates (u/w, v/w) are close
+ * to linear over short stretches. Each scanline is split into spans
+ * whose projected coordinates deviate from the chord between their end
+ * points by at most a fraction of a source pixel; each span is then
+ * sampled in one go as if the transform were affine. This replaces the
+ * per-pixel division, Jacobian and sampler call of transform_generic
+ * for samplers that do not look at the Jacobian. As it is approximate,
+ * it is only used below GeglConfig:quality 1.0.
+ */
+
+/*
+ * Largest deviation, in source pixels, of the affine approximation from
+ * the exact perspective, scaled up as GeglConfig:quality drops, up to 16
+ * times as much.
+ */
+#define GEGL_TRANSFORM_CORE_PERSPECTIVE_ERROR ((gdouble) 1.0 / 64)
+
+static void
+transform_perspective_row (GeglSampler           *sampler,
+                           GeglSamplerGetSpanFun  sampler_get_span_fun,
+                           const GeglMatrix3     *inverse,
+                           gdouble                u_float,
+                           gdouble                v_float,
+                           gdouble                w_float,
+                           gint                   n_pixels,
+                           gdouble                max_error,
+                           gfloat                *dest_ptr)
+{
+  const gdouble du = inverse->coeff [0][0];
+  const gdouble dv = inverse->coeff [1][0];
+  const gdouble dw = inverse->coeff [2][0];
+  gint          length = n_pixels;
+
+  while (n_pixels > 0)
+    {
+      const gdouble w_last = w_float + dw * (length - 1);
+      const gdouble mid    = (length - 1) * (gdouble) 0.5;
+      const gdouble w_mid  = w_float + dw * mid;
+
+      gdouble     u_first;
+      gdouble     v_first;
+      gdouble     u_last;
+      gdouble     v_last;
+      gdouble     u_mid;
+      gdouble     v_mid;
+      GeglMatrix2 inverse_jacobian;
+
+      if (length > 1 && (w_float <= 0.0 || w_last <= 0.0))
+        {
+          /* near the horizon; only single pixels are exact */
+          length = 1;
+          continue;
+        }
+
+      u_first = u_float / w_float;
+      v_first = v_float / w_float;
+      u_last  = (u_float + du * (length - 1)) / w_last;
+      v_last  = (v_float + dv * (length - 1)) / w_last;
+      u_mid   = (u_float + du * mid) / w_mid;
+      v_mid   = (v_float + dv * mid) / w_mid;
+
+      /* spans of one or two pixels are exact */
+      if (length > 2 &&
+          (fabs (u_mid - (u_first + u_last) * (gdouble) 0.5) > max_error ||
+           fabs (v_mid - (v_first + v_last) * (gdouble) 0.5) > max_error))
+        {
+          length = (length + 1) / 2;
+          continue;
+        }
+
+      inverse_jacobian.coeff [0][0] =
+        (inverse->coeff [0][0] - inverse->coeff [2][0] * u_mid) / w_mid;
+      inverse_jacobian.coeff [0][1] =
+        (inverse->coeff [0][1] - inverse->coeff [2][1] * u_mid) / w_mid;
+      inverse_jacobian.coeff [1][0] =
+        (inverse->coeff [1][0] - inverse->coeff [2][0] * v_mid) / w_mid;
+      inverse_jacobian.coeff [1][1] =
+        (inverse->coeff [1][1] - inverse->coeff [2][1] * v_mid) / w_mid;
+
+      sampler_get_span_fun (sampler,
+                            u_first, v_first,
+                            length > 1 ? (u_last - u_first) / (length - 1) : 0.0,
+                            length > 1 ? (v_last - v_first) / (length - 1) : 0.0,
+                            &inverse_jacobian,
+                            dest_ptr,
+                            length,
+                            GEGL_ABYSS_NONE);
+
+      dest_ptr += (gint) 4 * length;
+      u_float  += du * length;
+      v_float  += dv * length;
+      w_float  += dw * length;
+      n_pixels -= length;
+
+      /* the curvature changes slowly, so try a longer span next */
+      length = MIN (length * 2, n_pixels);
+    }
+}
+
+static void
+transform_perspective (GeglOperation       *operation,
+                       GeglBuffer          *dest,
+                       GeglBuffer          *src,
+                       GeglMatrix3         *matrix,
+                       const GeglRectangle *result,
+                       gint                 level)
+{
+  OpTransform         *transform = (OpTransform *) operation;
+  const Babl          *format = babl_format ("RaGaBaA float");
+  gint                 factor = 1 << level;
+  GeglBufferIterator  *i;
+  GeglMatrix3          inverse;
+  const gdouble        max_error =
+    GEGL_TRANSFORM_CORE_PERSPECTIVE_ERROR /
+    CLAMP (gegl_config ()->quality, (gdouble) 1.0 / 16, (gdouble) 1.0);
+  GeglSampler *sampler = gegl_buffer_sampler_new_at_level (src,
+                                         babl_format("RaGaBaA float"),
+                                         level?GEGL_SAMPLER_NEAREST:
+                                               transform->sampler,
+                                         level);
+  GeglSamplerGetSpanFun sampler_get_span_fun = gegl_sampler_get_span_fun (sampler);
+
+  i = gegl_buffer_iterator_new (dest,
+                                result,
+                                level,
+                                format,
+                                GEGL_ACCESS_WRITE,
+                                GEGL_ABYSS_NONE);
+
+  gegl_matrix3_copy_into (&inverse, matrix);
+
+  if (factor)
+  {
+    inverse.coeff[0][0] /= factor;
+    inverse.coeff[0][1] /= factor;
+    inverse.coeff[0][2] /= factor;
+    inverse.coeff[1][0] /= factor;
+    inverse.coeff[1][1] /= factor;
+    inverse.coeff[1][2] /= factor;
+  }
+
+  gegl_matrix3_invert (&inverse);
+
+  while (gegl_buffer_iterator_next (i))
+    {
+      GeglRectangle *roi = &i->roi[0];
+      gfloat        *dest_ptr = (gfloat *)i->data[0];
+      gint           y;
+
+      for (y = 0; y < roi->height; y++)
+        {
+          /*
+           * Each row starts from the exact homogeneous coordinates
+           * rather than accumulating steps down the tile.
+           */
+          const gdouble x_center = roi->x + (gdouble) 0.5;
+          const gdouble y_center = roi->y + y + (gdouble) 0.5;
+
+          transform_perspective_row (sampler, sampler_get_span_fun, &inverse,
+                                     inverse.coeff [0][0] * x_center +
+                                     inverse.coeff [0][1] * y_center +
+                                     inverse.coeff [0][2],
+                                     inverse.coeff [1][0] * x_center +
+                                     inverse.coeff [1][1] * y_center +
+                                     inverse.coeff [1][2],
+                                     inverse.coeff [2][0] * x_center +
+                                     inverse.coeff [2][1] * y_center +
+                                     inverse.coeff [2][2],
+                                     roi->width,
+                                     max_error,
+                                     dest_ptr);
+
+          dest_ptr += (gint) 4 * roi->width;
+        }
+    }
+
+  g_object_unref (sampler);
+}
+
+/*
+ * Separable resampling of axis-aligned scales (plus translation).
+ *
+ * The nearest, linear and cubic samplers evaluate kernels that are the
+ * product of a horizontal and a vertical one, so for such transforms the
+ * per-pixel sampler loop can be replaced by a horizontal pass followed
+ * by a vertical pass, both driven by weight tables computed once per
+ * output column and row. The results match the samplers'.
+ */
+
+/*
+ * Output rows are produced in bands, sized so that the source pixels
+ * fetched for a band stay below this many.
+ */
+#define TRANSFORM_SCALE_BAND_PIXELS (1 << 20)
+
+static gint
+transform_scale_taps (GeglSamplerType sampler)
+{
+  switch (sampler)
+    {
+      case GEGL_SAMPLER_NEAREST:
+        return 1;
+      case GEGL_SAMPLER_LINEAR:
+        return 2;
+      case GEGL_SAMPLER_CUBIC:
+        return 4;
+      default:
+        return 0;
+    }
+}
+
+/*
+ * Computes, for count output pixels starting at start, the first source
+ * pixel contributing to each of them and the weights of the taps. The
+ * cubic weights come from cubic, a GeglSamplerCubic, so that they follow
+ * its kernel parameters.
+ */
+static void
+transform_scale_weights (GeglSamplerType  sampler,
+                         GeglSampler     *cubic,
+                         gint             taps,
+                         gdouble          scale,
+                         gdouble          offset,
+                         gint             start,
+                         gint             count,
+                         gint            *first,
+                         gfloat          *weights)
+{
+  gint i;
+
+  for (i = 0; i < count; i++)
+    {
+      /* source coordinate of the output pixel's center */
+      const gdouble u  = scale * (start + i + (gdouble) 0.5) + offset;
+      const gdouble iu = u - (gdouble) 0.5;
+      const gint    ix = floor (iu);
+      const gfloat  fx = iu - ix;
+
+      switch (sampler)
+        {
+          case GEGL_SAMPLER_NEAREST:
+            first[i] = floor (u);
+            weights[i] = 1.0f;
+            break;
+
+          case GEGL_SAMPLER_LINEAR:
+            first[i] = ix;
+            weights[i * 2]     = 1.0f - fx;
+            weights[i * 2 + 1] = fx;
+            break;
+
+          default:
+            first[i] = ix - 1;
+            gegl_sampler_cubic_get_weights (GEGL_SAMPLER_CUBIC (cubic), fx,
+                                            weights + i * taps);
+            break;
+        }
+    }
+}
+
+static void
+transform_scale (GeglOperation       *operation,
+                 GeglBuffer          *dest,
+                 GeglBuffer          *src,
+                 GeglMatrix3         *matrix,
+                 const GeglRectangle *result,
+                 gint                 level)
+{
+  OpTransform *transform = (OpTransform *) operation;
+  const Babl  *format    = babl_format ("RaGaBaA float");
+  const gint   taps      = transform_scale_taps (transform->sampler);
+  GeglMatrix3  inverse;
+  GeglSampler *cubic     = NULL;
+  gint        *col_first;
+  gfloat      *col_weights;
+  gint        *row_first;
+  gfloat      *row_weights;
+  gfloat      *src_buf;
+  gfloat      *tmp_buf;
+  gfloat      *dest_buf;
+  gint         src_x;
+  gint         src_width;
+  gint         band_height;
+  gint         band_y;
+
+  if (result->width <= 0 || result->height <= 0)
+    return;
+
+  gegl_matrix3_copy_into (&inverse, matrix);
+  gegl_matrix3_invert (&inverse);
+
+  if (transform->sampler == GEGL_SAMPLER_CUBIC)
+    cubic = gegl_buffer_sampler_new_at_level (src, format,
+                                              GEGL_SAMPLER_CUBIC, 0);
+
+  col_first   = g_new (gint, result->width);
+  col_weights = g_new (gfloat, result->width * taps);
+  transform_scale_weights (transform->sampler, cubic, taps,
+                           inverse.coeff [0][0], inverse.coeff [0][2],
+                           result->x, result->width,
+                           col_first, col_weights);
+
+  /* the scale is positive, so the source columns increase monotonically */
+  src_x     = col_first[0];
+  src_width = col_first[result->width - 1] + taps - src_x;
+
+  band_height = TRANSFORM_SCALE_BAND_PIXELS /
+                (src_width * MAX (1, (gint) ceil (inverse.coeff [1][1])));
+  band_height = CLAMP (band_height, 1, result->height);
+
+  row_first   = g_new (gint, band_height);
+  row_weights = g_new (gfloat, band_height * taps);
+  dest_buf    = g_new (gfloat, result->width * band_height * 4);
+  tmp_buf     = NULL;
+  src_buf     = NULL;
+
+  for (band_y = result->y;
+       band_y < result->y + result->height;
+       band_y += band_height)
+    {
+      const gint    rows = MIN (band_height,
+                                result->y + result->height - band_y);
+      GeglRectangle src_rect;
+      GeglRectangle dest_rect;
+      gint          x, y, k;
+
+      transform_scale_weights (transform->sampler, cubic, taps,
+                               inverse.coeff [1][1], inverse.coeff [1][2],
+                               band_y, rows,
+                               row_first, row_weights);
+
+      src_rect.x      = src_x;
+      src_rect.y      = row_first[0];
+      src_rect.width  = src_width;
+      src_rect.height = row_first[rows - 1] + taps - row_first[0];
+
+      src_buf = g_renew (gfloat, src_buf, src_rect.width * src_rect.height * 4);
+      tmp_buf = g_renew (gfloat, tmp_buf, result->width * src_rect.height * 4);
+
+      gegl_buffer_get (src, &src_rect, 1.0, format, src_buf,
+                       GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+      /* horizontal pass, all source rows of the band */
+      for (y = 0; y < src_rect.height; y++)
+        {
+          const gfloat *src_row = src_buf + y * src_rect.width * 4;
+          gfloat       *tmp_row = tmp_buf + y * result->width * 4;
+
+          for (x = 0; x < result->width; x++)
+            {
+              const gfloat *s = src_row + (col_first[x] - src_x) * 4;
+              const gfloat *w = col_weights + x * taps;
+              gfloat        sum[4] = {0, 0, 0, 0};
+
+              for (k = 0; k < taps; k++, s += 4)
+                {
+                  sum[0] += w[k] * s[0];
+                  sum[1] += w[k] * s[1];
+                  sum[2] += w[k] * s[2];
+                  sum[3] += w[k] * s[3];
+                }
+
+              tmp_row[x * 4 + 0] = sum[0];
+              tmp_row[x * 4 + 1] = sum[1];
+              tmp_row[x * 4 + 2] = sum[2];
+              tmp_row[x * 4 + 3] = sum[3];
+            }
+        }
+
+      /* vertical pass, accumulating whole rows so the loop vectorizes */
+      for (y = 0; y < rows; y++)
+        {
+          const gfloat *w        = row_weights + y * taps;
+          gfloat       *dest_row = dest_buf + y * result->width * 4;
+
+          memset (dest_row, 0, result->width * 4 * sizeof (gfloat));
+
+          for (k = 0; k < taps; k++)
+            {
+              const gfloat *tmp_row = tmp_buf +
+                (row_first[y] - src_rect.y + k) * result->width * 4;
+              const gfloat  weight  = w[k];
+
+              for (x = 0; x < result->width * 4; x++)
+                dest_row[x] += weight * tmp_row[x];
+            }
+        }
+
+      dest_rect.x      = result->x;
+      dest_rect.y      = band_y;
+      dest_rect.width  = result->width;
+      dest_rect.height = rows;
+
+      gegl_buffer_set (dest, &dest_rect, 0, format, dest_buf,
+                       GEGL_AUTO_ROWSTRIDE);
+    }
+
+  g_free (src_buf);
+  g_free (tmp_buf);
+  g_free (dest_buf);
+  g_free (row_first);
+  g_free (row_weights);
+  g_free (col_first);
+  g_free (col_weights);
+
+  if (cubic)
+    g_object_unref (cubic);
+}
+
 /*
  * Use to determine if key transform matrix coefficients are close
  * enough to zero or integers.
@@ -1172,6 +1716,16 @@ static gboolean gegl_matrix3_is_affine (GeglMatrix3 *matrix)
           is_one  (matrix->coeff [2][2]));
 }
 
+static gboolean
+gegl_transform_matrix3_is_axis_aligned_scale (GeglMatrix3 *matrix)
+{
+  return (gegl_matrix3_is_affine (matrix) &&
+          is_zero (matrix->coeff [0][1]) &&
+          is_zero (matrix->coeff [1][0]) &&
+          matrix->coeff [0][0] > (gdouble) 0. &&
+          matrix->coeff [1][1] > (gdouble) 0.);
+}
+
 static gboolean
 gegl_transform_matrix3_allow_fast_translate (GeglMatrix3 *matrix)
 {
@@ -1194,6 +1748,558 @@ gegl_transform_matrix3_allow_fast_translate (GeglMatrix3 *matrix)
   return gegl_matrix3_is_translate (matrix);
 }
 
+/*
+ * Largest number of pixels kept in the source cache of one operation,
+ * over all levels. Requests needing more of a single level (e.g. of
+ * infinite inputs) sample the input directly.
+ */
+#define GEGL_TRANSFORM_CORE_SOURCE_MAX_PIXELS (1 << 24)
+
+/*
+ * Converts a rectangle in level 0 coordinates to the smallest rectangle
+ * at mipmap level "level" covering it.
+ */
+static void
+gegl_transform_level_rect (const GeglRectangle *rect,
+                           gint                 level,
+                           GeglRectangle       *output)
+{
+  const gdouble factor = 1 << level;
+  gint          x1 = floor (rect->x / factor);
+  gint          y1 = floor (rect->y / factor);
+  gint          x2 = ceil ((rect->x + (gdouble) rect->width)  / factor);
+  gint          y2 = ceil ((rect->y + (gdouble) rect->height) / factor);
+
+  gegl_rectangle_set (output, x1, y1, x2 - x1, y2 - y1);
+}
+
+/*
+ * The input pixels needed for "result" at mipmap level "level", in the
+ * coordinates of that level, grown by "context" when given.
+ */
+static void
+gegl_transform_get_level_need (OpTransform         *transform,
+                               GeglBuffer          *input,
+                               const GeglRectangle *result,
+                               gint                 level,
+                               const GeglRectangle *context,
+                               GeglRectangle       *need)
+{
+  *need = gegl_transform_get_required_for_output (GEGL_OPERATION (transform),
+                                                  "input", result);
+  gegl_rectangle_intersect (need, need, gegl_buffer_get_extent (input));
+  gegl_transform_level_rect (need, level, need);
+
+  if (context && need->width > 0 && need->height > 0)
+    {
+      need->x      += context->x;
+      need->y      += context->y;
+      need->width  += context->width  - (gint) 1;
+      need->height += context->height - (gint) 1;
+    }
+}
+
+static void
+gegl_transform_get_abyss (GeglBuffer    *buffer,
+                          GeglRectangle *abyss)
+{
+  g_object_get (buffer,
+                "abyss-x",      &abyss->x,
+                "abyss-y",      &abyss->y,
+                "abyss-width",  &abyss->width,
+                "abyss-height", &abyss->height,
+                NULL);
+}
+
+static void
+gegl_transform_invalidated (GeglNode            *node,
+                            const GeglRectangle *rect,
+                            OpTransform         *transform)
+{
+  GeglRectangle source_rect;
+  gint          level;
+
+  /*
+   * Map the dirty output back to the input; this covers whatever input
+   * change caused it. Invalidations that stem from property changes
+   * drop a few cached pixels needlessly, which is harmless.
+   */
+  source_rect =
+    gegl_transform_get_required_for_output (GEGL_OPERATION (transform),
+                                            "input", rect);
+
+  g_mutex_lock (&transform->source_mutex);
+
+  for (level = 1; level < GEGL_TRANSFORM_CORE_SOURCE_LEVELS; level++)
+    if (transform->source_cache[level])
+      {
+        GeglRectangle  level_rect;
+        GeglRegion    *region;
+
+        gegl_transform_level_rect (&source_rect, level, &level_rect);
+
+        region = gegl_region_rectangle (&level_rect);
+        gegl_region_subtract (transform->source_valid[level], region);
+        gegl_region_destroy (region);
+      }
+
+  g_mutex_unlock (&transform->source_mutex);
+}
+
+static gint64
+gegl_transform_region_pixels (GeglRegion *region)
+{
+  GeglRectangle *rects;
+  gint           n_rects;
+  gint           i;
+  gint64         pixels = 0;
+
+  gegl_region_get_rectangles (region, &rects, &n_rects);
+
+  for (i = 0; i < n_rects; i++)
+    pixels += (gint64) rects[i].width * rects[i].height;
+
+  g_free (rects);
+
+  return pixels;
+}
+
+/* Frees a level of the source cache, called with source_mutex held. */
+static void
+gegl_transform_drop_source_level (OpTransform *transform,
+                                  gint         level)
+{
+  if (transform->source_cache[level])
+    {
+      g_object_unref (transform->source_cache[level]);
+      transform->source_cache[level] = NULL;
+    }
+
+  gegl_region_destroy (transform->source_valid[level]);
+  transform->source_valid[level] = gegl_region_new ();
+}
+
+/*
+ * Returns a buffer to sample "input" from at mipmap level "level".
+ *
+ * The mipmap tiles of the input are usually rebuilt for every render,
+ * since the input rarely is a cache. The pixels needed for "result",
+ * plus "context" pixels of the level around them, are instead copied
+ * into the matching level of a buffer owned by the operation and are
+ * reused, until invalidated, when zooming and panning.
+ */
+static GeglBuffer *
+gegl_transform_get_cached_source (OpTransform         *transform,
+                                  GeglBuffer          *input,
+                                  const GeglRectangle *result,
+                                  gint                 level,
+                                  const GeglRectangle *context)
+{
+  const Babl    *format = gegl_buffer_get_format (input);
+  const gint     bpp    = babl_format_get_bytes_per_pixel (format);
+  const gint     factor = 1 << level;
+  const gdouble  scale  = 1.0 / factor;
+  GeglRectangle  extent = *gegl_buffer_get_extent (input);
+  GeglRectangle  abyss;
+  GeglRectangle  need;
+  GeglRegion    *missing;
+  GeglRectangle *rects;
+  gint           n_rects;
+  gint           i;
+  gint           l;
+  gint64         pixels;
+  GeglBuffer    *cached = NULL;
+  GeglBuffer    *source;
+
+  gegl_transform_get_level_need (transform, input, result, level, context,
+                                 &need);
+
+  if (need.width <= 0 || need.height <= 0 ||
+      (gint64) need.width * need.height > GEGL_TRANSFORM_CORE_SOURCE_MAX_PIXELS)
+    return g_object_ref (input);
+
+  gegl_transform_get_abyss (input, &abyss);
+
+  g_mutex_lock (&transform->source_mutex);
+
+  /* all levels share the shape of the input, which may have changed */
+  for (l = 0; l < GEGL_TRANSFORM_CORE_SOURCE_LEVELS && ! cached; l++)
+    cached = transform->source_cache[l];
+
+  if (cached)
+    {
+      GeglRectangle cache_abyss;
+
+      gegl_transform_get_abyss (cached, &cache_abyss);
+
+      if (gegl_buffer_get_format (cached) != format ||
+          ! gegl_rectangle_equal (gegl_buffer_get_extent (cached), &extent) ||
+          ! gegl_rectangle_equal (&cache_abyss, &abyss))
+        {
+          for (l = 0; l < GEGL_TRANSFORM_CORE_SOURCE_LEVELS; l++)
+            gegl_transform_drop_source_level (transform, l);
+        }
+    }
+
+  transform->source_used[level] = ++transform->source_serial;
+
+  missing = gegl_region_rectangle (&need);
+  gegl_region_subtract (missing, transform->source_valid[level]);
+
+  /*
+   * Keep the cache within GEGL_TRANSFORM_CORE_SOURCE_MAX_PIXELS by
+   * dropping the levels used least recently, and, if that is not enough,
+   * what this level holds outside of this request.
+   */
+  pixels = gegl_transform_region_pixels (missing);
+  for (l = 0; l < GEGL_TRANSFORM_CORE_SOURCE_LEVELS; l++)
+    pixels += gegl_transform_region_pixels (transform->source_valid[l]);
+
+  while (pixels > GEGL_TRANSFORM_CORE_SOURCE_MAX_PIXELS)
+    {
+      gint oldest = -1;
+
+      for (l = 0; l < GEGL_TRANSFORM_CORE_SOURCE_LEVELS; l++)
+        if (l != level && transform->source_cache[l] &&
+            (oldest < 0 ||
+             transform->source_used[l] < transform->source_used[oldest]))
+          oldest = l;
+
+      if (oldest < 0)
+        {
+          gegl_transform_drop_source_level (transform, level);
+          gegl_region_destroy (missing);
+          missing = gegl_region_rectangle (&need);
+          break;
+        }
+
+      pixels -= gegl_transform_region_pixels (transform->source_valid[oldest]);
+      gegl_transform_drop_source_level (transform, oldest);
+    }
+
+  if (! transform->source_cache[level])
+    {
+      transform->source_cache[level] = gegl_buffer_new (&extent, format);
+      gegl_buffer_set_abyss (transform->source_cache[level], &abyss);
+    }
+
+  gegl_region_get_rectangles (missing, &rects, &n_rects);
+
+  for (i = 0; i < n_rects; i++)
+    {
+      const gint band_height =
+        CLAMP (TRANSFORM_SCALE_BAND_PIXELS / rects[i].width, 1, rects[i].height);
+      guchar    *buf = g_malloc ((gsize) bpp * rects[i].width * band_height);
+      gint       y;
+
+      for (y = 0; y < rects[i].height; y += band_height)
+        {
+          GeglRectangle band = {rects[i].x, rects[i].y + y, rects[i].width,
+                                MIN (band_height, rects[i].height - y)};
+          /* writes at a level take level 0 coordinates */
+          GeglRectangle band_rect = {band.x * factor, band.y * factor,
+                                     band.width * factor, band.height * factor};
+
+          gegl_buffer_get (input, &band, scale, format, buf,
+                           GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+          gegl_buffer_set (transform->source_cache[level], &band_rect, level,
+                           format, buf, GEGL_AUTO_ROWSTRIDE);
+        }
+
+      g_free (buf);
+    }
+
+  g_free (rects);
+
+  gegl_region_union (transform->source_valid[level], missing);
+  gegl_region_destroy (missing);
+
+  source = g_object_ref (transform->source_cache[level]);
+
+  g_mutex_unlock (&transform->source_mutex);
+
+  return source;
+}
+
+static void
+gegl_transform_render (GeglOperation       *operation,
+                       void               (*func) (GeglOperation       *operation,
+                                                   GeglBuffer          *dest,
+                                                   GeglBuffer          *src,
+                                                   GeglMatrix3         *matrix,
+                                                   const GeglRectangle *result,
+                                                   gint                 level),
+                       GeglBuffer          *output,
+                       GeglBuffer          *input,
+                       GeglMatrix3         *matrix,
+                       const GeglRectangle *result,
+                       gint                 level)
+{
+  if (gegl_operation_use_threading (operation, result))
+  {
+    gint threads = gegl_config_threads ();
+    GThreadPool *pool = thread_pool ();
+    ThreadData thread_data[GEGL_MAX_THREADS];
+    gint pending = threads;
+
+    if (result->width > result->height)
+    {
+      gint bit = result->width / threads;
+      for (gint j = 0; j < threads; j++)
+      {
+        thread_data[j].roi.y = result->y;
+        thread_data[j].roi.height = result->height;
+        thread_data[j].roi.x = result->x + bit * j;
+        thread_data[j].roi.width = bit;
+      }
+      thread_data[threads-1].roi.width = result->width - (bit * (threads-1));
+    }
+    else
+    {
+      gint bit = result->height / threads;
+      for (gint j = 0; j < threads; j++)
+      {
+        thread_data[j].roi.x = result->x;
+        thread_data[j].roi.width = result->width;
+        thread_data[j].roi.y = result->y + bit * j;
+        thread_data[j].roi.height = bit;
+      }
+      thread_data[threads-1].roi.height = result->height - (bit * (threads-1));
+    }
+
+    for (gint i = 0; i < threads; i++)
+    {
+      thread_data[i].func = func;
+      thread_data[i].matrix = matrix;
+      thread_data[i].operation = operation;
+      thread_data[i].input = input;
+      thread_data[i].output = output;
+      thread_data[i].pending = &pending;
+      thread_data[i].level = level;
+      thread_data[i].success = TRUE;
+    }
+
+    for (gint i = 1; i < threads; i++)
+      g_thread_pool_push (pool, &thread_data[i], NULL);
+    thread_process (&thread_data[0], NULL);
+
+    while (g_atomic_int_get (&pending)) {};
+  }
+  else
+  {
+    func (operation, output, input, matrix, result, level);
+  }
+}
+
+/*
+ * With the mipmap property set, strong nohalo and lohalo downscales are
+ * resampled from the mipmap pyramid of the input, trilinear style: the
+ * level is picked from the inverse Jacobian so that the sampler's
+ * footprint stays a few pixels wide whatever the scale factor, and the
+ * two levels around the ideal one are blended. This trades the exact
+ * EWA footprint for the box filtered pyramid, which is why it has to be
+ * asked for; otherwise the input is always sampled directly.
+ *
+ * Only used for affine transforms, whose Jacobian is constant.
+ */
+static gboolean
+gegl_transform_get_mipmap_level (OpTransform *transform,
+                                 GeglMatrix3 *matrix,
+                                 gint        *level,
+                                 gdouble     *blend)
+{
+  GeglMatrix3 inverse;
+  gdouble     sum;
+  gdouble     det;
+  gdouble     stretch;
+  gdouble     lod;
+
+  if (! transform->mipmap)
+    return FALSE;
+
+  if (transform->sampler != GEGL_SAMPLER_NOHALO &&
+      transform->sampler != GEGL_SAMPLER_LOHALO)
+    return FALSE;
+
+  gegl_matrix3_copy_into (&inverse, matrix);
+  gegl_matrix3_invert (&inverse);
+
+  /*
+   * Largest singular value of the inverse Jacobian, that is, how many
+   * input pixels the longest axis of an output pixel's footprint spans.
+   */
+  sum = inverse.coeff [0][0] * inverse.coeff [0][0] +
+        inverse.coeff [0][1] * inverse.coeff [0][1] +
+        inverse.coeff [1][0] * inverse.coeff [1][0] +
+        inverse.coeff [1][1] * inverse.coeff [1][1];
+  det = inverse.coeff [0][0] * inverse.coeff [1][1] -
+        inverse.coeff [0][1] * inverse.coeff [1][0];
+  stretch = sqrt ((sum + sqrt (MAX (sum * sum - 4.0 * det * det, 0.0))) * 0.5);
+
+  /*
+   * These filter downscales by up to 2 well themselves, the pyramid is
+   * only used from 1:4 on.
+   */
+  lod = log2 (stretch) - 1.0;
+
+  if (! (lod >= 1.0))
+    return FALSE;
+
+  *level = floor (lod);
+  *blend = lod - *level;
+
+  if (*level >= GEGL_TRANSFORM_CORE_SOURCE_LEVELS - 1)
+    {
+      *level = GEGL_TRANSFORM_CORE_SOURCE_LEVELS - 1;
+      *blend = 0.0;
+    }
+
+  return TRUE;
+}
+
+/*
+ * Returns the input pixels needed for "result" at mipmap level "level"
+ * as a level 0 buffer in the coordinates of that level. The level is
+ * downsampled into the source cache once and reused by later renders,
+ * the returned buffer only wraps a copy of the part this one needs.
+ */
+static GeglBuffer *
+gegl_transform_get_level_source (OpTransform         *transform,
+                                 GeglBuffer          *input,
+                                 const GeglRectangle *result,
+                                 gint                 level)
+{
+  const Babl    *format = babl_format ("RaGaBaA float");
+  GeglRectangle  need;
+  GeglRectangle  context_rect;
+  GeglSampler   *sampler;
+  GeglBuffer    *source;
+  gfloat        *buf;
+
+  /* the sampler's context, now in pixels of the level */
+  sampler = gegl_buffer_sampler_new_at_level (NULL, format,
+                                              transform->sampler, 0);
+  context_rect = *gegl_sampler_get_context_rect (sampler);
+  g_object_unref (sampler);
+
+  gegl_transform_get_level_need (transform, input, result, level,
+                                 &context_rect, &need);
+
+  if (need.width <= 0 || need.height <= 0)
+    return gegl_buffer_new (&need, format);
+
+  source = gegl_transform_get_cached_source (transform, input, result, level,
+                                             &context_rect);
+
+  buf = g_new (gfloat, (gsize) 4 * need.width * need.height);
+  gegl_buffer_get (source, &need, 1.0 / (1 << level), format, buf,
+                   GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+  g_object_unref (source);
+
+  return gegl_buffer_linear_new_from_data (buf, format, &need,
+                                           GEGL_AUTO_ROWSTRIDE,
+                                           (GDestroyNotify) g_free, buf);
+}
+
+static void
+gegl_transform_render_level (GeglOperation       *operation,
+                             void               (*func) (GeglOperation       *operation,
+                                                         GeglBuffer          *dest,
+                                                         GeglBuffer          *src,
+                                                         GeglMatrix3         *matrix,
+                                                         const GeglRectangle *result,
+                                                         gint                 level),
+                             GeglBuffer          *output,
+                             GeglBuffer          *input,
+                             GeglMatrix3         *matrix,
+                             const GeglRectangle *result,
+                             gint                 mipmap_level)
+{
+  const gdouble  factor = 1 << mipmap_level;
+  GeglBuffer    *source;
+  GeglMatrix3    level_matrix;
+  gint           i;
+
+  source = gegl_transform_get_level_source ((OpTransform *) operation,
+                                            input, result, mipmap_level);
+
+  /* map level coordinates to level 0 ones before applying the transform */
+  gegl_matrix3_copy_into (&level_matrix, matrix);
+  for (i = 0; i < 3; i++)
+    {
+      level_matrix.coeff [i][0] *= factor;
+      level_matrix.coeff [i][1] *= factor;
+    }
+
+  gegl_transform_render (operation, func, output, source,
+                         &level_matrix, result, 0);
+
+  g_object_unref (source);
+}
+
+static void
+gegl_transform_render_mipmapped (GeglOperation       *operation,
+                                 void               (*func) (GeglOperation       *operation,
+                                                             GeglBuffer          *dest,
+                                                             GeglBuffer          *src,
+                                                             GeglMatrix3         *matrix,
+                                                             const GeglRectangle *result,
+                                                             gint                 level),
+                                 GeglBuffer          *output,
+                                 GeglBuffer          *input,
+                                 GeglMatrix3         *matrix,
+                                 const GeglRectangle *result,
+                                 gint                 mipmap_level,
+                                 gdouble              blend)
+{
+  const Babl         *format = babl_format ("RaGaBaA float");
+  GeglBuffer         *coarse;
+  GeglBufferIterator *i;
+
+  gegl_transform_render_level (operation, func, output, input, matrix,
+                               result, mipmap_level);
+
+  /* blends below 8 bit precision are not worth a second pass */
+  if (blend < 1.0 / 256)
+    return;
+
+  coarse = gegl_buffer_new (result, format);
+
+  gegl_transform_render_level (operation, func, coarse, input, matrix,
+                               result, mipmap_level + 1);
+
+  i = gegl_buffer_iterator_new (output, result, 0, format,
+                                GEGL_ACCESS_READWRITE, GEGL_ABYSS_NONE);
+  gegl_buffer_iterator_add (i, coarse, result, 0, format,
+                            GEGL_ACCESS_READ, GEGL_ABYSS_NONE);
+
+  while (gegl_buffer_iterator_next (i))
+    {
+      gfloat       *out = i->data[0];
+      const gfloat *in  = i->data[1];
+      gint          n;
+
+      for (n = 0; n < i->length * 4; n++)
+        out[n] += (gfloat) blend * (in[n] - out[n]);
+    }
+
+  g_object_unref (coarse);
+}
+
+/* The cases gegl_transform_process () passes the input through in
+ */
+static gboolean
+gegl_transform_is_operation_a_nop (GeglOperation *operation)
+{
+  OpTransform *transform = (OpTransform *) operation;
+  GeglMatrix3  matrix;
+
+  gegl_transform_create_composite_matrix (transform, &matrix);
+
+  return gegl_transform_is_intermediate_node (transform) ||
+         gegl_matrix3_is_identity (&matrix);
+}
+
 static gboolean
 gegl_transform_process (GeglOperation        *operation,
                         GeglOperationContext *context,
@@ -1254,14 +2360,25 @@ gegl_transform_process (GeglOperation        *operation,
     }
   else
     {
-      void (*func) (GeglOperation *operation,
-                    GeglBuffer  *dest,
-                    GeglBuffer  *src,
-                    GeglMatrix3 *matrix,
-                    gint         level) = transform_generic;
+      void (*func) (GeglOperation       *operation,
+                    GeglBuffer          *dest,
+                    GeglBuffer          *src,
+                    GeglMatrix3         *matrix,
+                    const GeglRectangle *result,
+                    gint                 level) = transform_generic;
+      gint    mipmap_level;
+      gdouble blend;
 
       if (gegl_matrix3_is_affine (&matrix))
         func = transform_affine;
+      else if (gegl_config ()->quality < 1.0 &&
+               (level || transform_scale_taps (transform->sampler)))
+        func = transform_perspective;
+
+      if (level == 0 &&
+          transform_scale_taps (transform->sampler) &&
+          gegl_transform_matrix3_is_axis_aligned_scale (&matrix))
+        func = transform_scale;
 
       /*
        * For all other cases, do a proper resampling
@@ -1269,60 +2386,26 @@ gegl_transform_process (GeglOperation        *operation,
       input  = gegl_operation_context_get_source (context, "input");
       output = gegl_operation_context_get_target (context, "output");
 
-      if (gegl_operation_use_threading (operation, result))
-      {
-        gint threads = gegl_config_threads ();
-        GThreadPool *pool = thread_pool ();
-        ThreadData thread_data[GEGL_MAX_THREADS];
-        gint pending = threads;
-
-        if (result->width > result->height)
-        {
-          gint bit = result->width / threads;
-          for (gint j = 0; j < threads; j++)
-          {
-            thread_data[j].roi.y = result->y;
-            thread_data[j].roi.height = result->height;
-            thread_data[j].roi.x = result->x + bit * j;
-            thread_data[j].roi.width = bit;
-          }
-          thread_data[threads-1].roi.width = result->width - (bit * (threads-1));
-        }
-        else
+      if (input && level > 0 && level < GEGL_TRANSFORM_CORE_SOURCE_LEVELS)
         {
-          gint bit = result->height / threads;
-          for (gint j = 0; j < threads; j++)
-          {
-            thread_data[j].roi.x = result->x;
-            thread_data[j].roi.width = result->width;
-            thread_data[j].roi.y = result->y + bit * j;
-            thread_data[j].roi.height = bit;
-          }
-          thread_data[threads-1].roi.height = result->height - (bit * (threads-1));
-        }
+          GeglBuffer *source =
+            gegl_transform_get_cached_source (transform, input, result, level,
+                                              NULL);
 
-        for (gint i = 0; i < threads; i++)
-        {
-          thread_data[i].func = func;
-          thread_data[i].matrix = &matrix;
-          thread_data[i].operation = operation;
-          thread_data[i].input = input;
-          thread_data[i].output = output;
-          thread_data[i].pending = &pending;
-          thread_data[i].level = level;
-          thread_data[i].success = TRUE;
+          g_object_unref (input);
+          input = source;
         }
 
-        for (gint i = 1; i < threads; i++)
-          g_thread_pool_push (pool, &thread_data[i], NULL);
-        thread_process (&thread_data[0], NULL);
-
-        while (g_atomic_int_get (&pending)) {};
-      }
+      if (input && level == 0 &&
+          gegl_matrix3_is_affine (&matrix) &&
+          gegl_transform_get_mipmap_level (transform, &matrix,
+                                           &mipmap_level, &blend))
+        gegl_transform_render_mipmapped (operation, func, output, input,
+                                         &matrix, result,
+                                         mipmap_level, blend);
       else
-      {
-        func (operation, output, input, &matrix, level);
-      }
+        gegl_transform_render (operation, func, output, input,
+                               &matrix, result, level);
 
       if (input != NULL)
         g_object_unref (input);
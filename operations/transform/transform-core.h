@@ -12,6 +12,9 @@ G_BEGIN_DECLS
 #define IS_OP_TRANSFORM_CLASS(klass)    (G_TYPE_CHECK_CLASS_TYPE ((klass),  TYPE_OP_TRANSFORM))
 #define OP_TRANSFORM_GET_CLASS(obj)     (G_TYPE_INSTANCE_GET_CLASS ((obj),  TYPE_OP_TRANSFORM, OpTransformClass))
 
+/* Number of mipmap levels for which the downsampled input is kept. */
+#define GEGL_TRANSFORM_CORE_SOURCE_LEVELS 8
+
 typedef struct _OpTransform OpTransform;
 
 struct _OpTransform
@@ -20,6 +23,17 @@ struct _OpTransform
   gdouble             origin_x;
   gdouble             origin_y;
   GeglSamplerType     sampler;
+  gboolean            mipmap;
+
+  /* downsampled copies of the input, a buffer holding the matching
+   * mipmap level per rendered level, the parts of each level that are
+   * valid and when each level was last used
+   */
+  GMutex              source_mutex;
+  GeglBuffer         *source_cache[GEGL_TRANSFORM_CORE_SOURCE_LEVELS];
+  struct _GeglRegion *source_valid[GEGL_TRANSFORM_CORE_SOURCE_LEVELS];
+  guint               source_used[GEGL_TRANSFORM_CORE_SOURCE_LEVELS];
+  guint               source_serial;
 };
 
 typedef struct _OpTransformClass OpTransformClass;
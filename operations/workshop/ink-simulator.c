@@ -1418,6 +1418,7 @@ gegl_op_class_init (GeglOpClass *klass)
   gegl_operation_class_set_keys (operation_class,
   "name"        , "gegl:ink-simulator",
   "title"       , _("Ink Simulator"),
+  "position-dependent", "true",
   "categories"  , "misc",
   "description" ,
         _("Spectral ink and paint simulator, for softproofing/simulating physical color mixing and interactions."
@@ -0,0 +1,209 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define SIZE     300
+#define N_RECTS  8
+
+/* gegl_buffer_get_many () and gegl_buffer_set_many () have to give the
+ * same results as gegl_buffer_get () and gegl_buffer_set () called for
+ * each rectangle. The rectangles cross tiles, reach into or lie in the
+ * abyss, overlap and are empty; they are moved in the buffer's format
+ * and in another one. Buffers with 64x64 tiles share the tiles between
+ * the rectangles, those with 4x4 tiles have too many in the batch's
+ * bounding box and take the fallback.
+ */
+
+static const GeglRectangle rects[N_RECTS] =
+{
+  {  10,  20,   1, 200 },
+  {  11,  20,   1, 200 },
+  {  60,  60, 100,  20 },
+  {  -3, 100,  10,  10 },
+  { 290, 280,  20,  30 },
+  { 400, 400,  10,  10 },
+  {  50,  50,   0,  10 },
+  {   0,   0, SIZE, SIZE }
+};
+
+static GeglBuffer *
+new_buffer (gint tile_size)
+{
+  return g_object_new (GEGL_TYPE_BUFFER,
+                       "x",           0,
+                       "y",           0,
+                       "width",       SIZE,
+                       "height",      SIZE,
+                       "tile-width",  tile_size,
+                       "tile-height", tile_size,
+                       "format",      babl_format ("RGBA float"),
+                       NULL);
+}
+
+static void
+fill_noise (GeglBuffer *buffer,
+            guint32     seed)
+{
+  gfloat *pixels = g_new (gfloat, SIZE * SIZE * 4);
+  gint    i;
+
+  for (i = 0; i < SIZE * SIZE * 4; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      pixels[i] = ((seed >> 16) & 0xff) / 255.0;
+    }
+
+  gegl_buffer_set (buffer, NULL, 0, babl_format ("RGBA float"), pixels,
+                   GEGL_AUTO_ROWSTRIDE);
+  g_free (pixels);
+}
+
+static gboolean
+test_get_many (gint             tile_size,
+               const gchar     *format_name,
+               GeglAbyssPolicy  abyss)
+{
+  const Babl *format = babl_format (format_name);
+  gint        bpp    = babl_format_get_bytes_per_pixel (format);
+  GeglBuffer *buffer = new_buffer (tile_size);
+  gpointer    many[N_RECTS];
+  gpointer    single[N_RECTS];
+  gboolean    result = TRUE;
+  gint        i;
+
+  fill_noise (buffer, 1);
+
+  for (i = 0; i < N_RECTS; i++)
+    {
+      gsize size = MAX (rects[i].width * rects[i].height * bpp, 1);
+
+      many[i]   = g_malloc0 (size);
+      single[i] = g_malloc0 (size);
+
+      gegl_buffer_get (buffer, &rects[i], 1.0, format, single[i],
+                       GEGL_AUTO_ROWSTRIDE, abyss);
+    }
+
+  gegl_buffer_get_many (buffer, rects, N_RECTS, format, many,
+                        GEGL_AUTO_ROWSTRIDE, abyss);
+
+  for (i = 0; i < N_RECTS; i++)
+    {
+      if (memcmp (many[i], single[i], rects[i].width * rects[i].height * bpp))
+        {
+          g_printerr ("get, %dx%d tiles, %s, abyss %d: rectangle %d differs\n",
+                      tile_size, tile_size, format_name, abyss, i);
+          result = FALSE;
+        }
+
+      g_free (many[i]);
+      g_free (single[i]);
+    }
+
+  g_object_unref (buffer);
+
+  return result;
+}
+
+static gboolean
+test_set_many (gint         tile_size,
+               const gchar *format_name)
+{
+  const Babl *format  = babl_format (format_name);
+  const Babl *compare = babl_format ("RGBA float");
+  gint        bpp     = babl_format_get_bytes_per_pixel (format);
+  GeglBuffer *many    = new_buffer (tile_size);
+  GeglBuffer *single  = new_buffer (tile_size);
+  GeglBuffer *source  = new_buffer (tile_size);
+  gpointer    data[N_RECTS];
+  gfloat     *many_pixels   = g_new (gfloat, SIZE * SIZE * 4);
+  gfloat     *single_pixels = g_new (gfloat, SIZE * SIZE * 4);
+  gboolean    result = TRUE;
+  gint        i;
+
+  fill_noise (many, 1);
+  fill_noise (single, 1);
+  fill_noise (source, 2);
+
+  for (i = 0; i < N_RECTS; i++)
+    {
+      data[i] = g_malloc0 (MAX (rects[i].width * rects[i].height * bpp, 1));
+
+      gegl_buffer_get (source, &rects[i], 1.0, format, data[i],
+                       GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+      /* make the overlapping rectangles disagree */
+      if (rects[i].width * rects[i].height * bpp > 0)
+        ((guchar *) data[i])[0] ^= 0xff;
+
+      gegl_buffer_set (single, &rects[i], 0, format, data[i],
+                       GEGL_AUTO_ROWSTRIDE);
+    }
+
+  gegl_buffer_set_many (many, rects, N_RECTS, format, data,
+                        GEGL_AUTO_ROWSTRIDE);
+
+  gegl_buffer_get (many, NULL, 1.0, compare, many_pixels,
+                   GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+  gegl_buffer_get (single, NULL, 1.0, compare, single_pixels,
+                   GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+  if (memcmp (many_pixels, single_pixels, SIZE * SIZE * 4 * sizeof (gfloat)))
+    {
+      g_printerr ("set, %dx%d tiles, %s: buffers differ\n",
+                  tile_size, tile_size, format_name);
+      result = FALSE;
+    }
+
+  for (i = 0; i < N_RECTS; i++)
+    g_free (data[i]);
+  g_free (many_pixels);
+  g_free (single_pixels);
+  g_object_unref (many);
+  g_object_unref (single);
+  g_object_unref (source);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  int   result = SUCCESS;
+  gint  tile_sizes[] = { 64, 4 };
+  gint  i;
+
+  gegl_init (&argc, &argv);
+
+  for (i = 0; i < (gint) G_N_ELEMENTS (tile_sizes); i++)
+    {
+      if (!test_get_many (tile_sizes[i], "RGBA float", GEGL_ABYSS_NONE) ||
+          !test_get_many (tile_sizes[i], "RGBA float", GEGL_ABYSS_CLAMP) ||
+          !test_get_many (tile_sizes[i], "R'G'B'A u8", GEGL_ABYSS_NONE) ||
+          !test_get_many (tile_sizes[i], "R'G'B'A u8", GEGL_ABYSS_CLAMP) ||
+          !test_set_many (tile_sizes[i], "RGBA float") ||
+          !test_set_many (tile_sizes[i], "R'G'B'A u8"))
+        result = FAILURE;
+    }
+
+  gegl_exit ();
+
+  return result;
+}
@@ -0,0 +1,167 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define WIDTH    200
+#define HEIGHT   300
+
+/* Inverts a buffer into another one with gegl_buffer_iterator_foreach ()
+ * on several threads, summing up the input on the way. The written buffer
+ * has tiles of another height than the read one, once with tile rows that
+ * line up with those of the read buffer and once shifted against them.
+ */
+
+static guchar
+source_value (gint x,
+              gint y)
+{
+  return (x * 7 + y * 13) & 0xff;
+}
+
+static void
+invert_chunk (GeglBufferIterator *iter,
+              gpointer            state,
+              gpointer            user_data)
+{
+  guint64 *sum = state;
+  guchar  *in  = iter->data[0];
+  guchar  *out = iter->data[1];
+  gint     i;
+
+  for (i = 0; i < iter->length; i++)
+    {
+      *sum += in[i];
+      out[i] = 255 - in[i];
+    }
+}
+
+static void
+sum_merge (gpointer result,
+           gpointer state,
+           gpointer user_data)
+{
+  *(guint64 *) result += *(guint64 *) state;
+}
+
+static gboolean
+test_foreach (GeglBuffer  *source,
+              gint         tile_height,
+              gint         offset,
+              const gchar *name)
+{
+  const Babl         *format = babl_format ("Y u8");
+  guchar             *pixels = g_new (guchar, WIDTH * HEIGHT);
+  gboolean            result = TRUE;
+  guint64             sum = 0;
+  guint64             expected_sum = 0;
+  GeglBuffer         *dest;
+  GeglBufferIterator *iter;
+  gint                x, y;
+
+  dest = g_object_new (GEGL_TYPE_BUFFER,
+                       "x",           0,
+                       "y",           0,
+                       "width",       WIDTH,
+                       "height",      HEIGHT + offset,
+                       "tile-width",  64,
+                       "tile-height", tile_height,
+                       "format",      format,
+                       NULL);
+
+  iter = gegl_buffer_iterator_new (source, GEGL_RECTANGLE (0, 0, WIDTH, HEIGHT),
+                                   0, format,
+                                   GEGL_ACCESS_READ, GEGL_ABYSS_NONE);
+  gegl_buffer_iterator_add (iter, dest,
+                            GEGL_RECTANGLE (0, offset, WIDTH, HEIGHT),
+                            0, format,
+                            GEGL_ACCESS_WRITE, GEGL_ABYSS_NONE);
+
+  gegl_buffer_iterator_foreach (iter, invert_chunk, &sum, sizeof (sum),
+                                sum_merge, NULL);
+
+  gegl_buffer_get (dest, GEGL_RECTANGLE (0, offset, WIDTH, HEIGHT), 1.0,
+                   format, pixels, GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+  for (y = 0; y < HEIGHT; y++)
+    for (x = 0; x < WIDTH; x++)
+      {
+        expected_sum += source_value (x, y);
+
+        if (result && pixels[y * WIDTH + x] != 255 - source_value (x, y))
+          {
+            g_printerr ("%s: pixel %d,%d is %d, expected %d\n",
+                        name, x, y, pixels[y * WIDTH + x],
+                        255 - source_value (x, y));
+            result = FALSE;
+          }
+      }
+
+  if (sum != expected_sum)
+    {
+      g_printerr ("%s: sum is %" G_GUINT64_FORMAT ", expected %"
+                  G_GUINT64_FORMAT "\n", name, sum, expected_sum);
+      result = FALSE;
+    }
+
+  g_object_unref (dest);
+  g_free (pixels);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  int         result = SUCCESS;
+  const Babl *format;
+  guchar     *pixels = g_new (guchar, WIDTH * HEIGHT);
+  GeglBuffer *source;
+  gint        x, y;
+
+  gegl_init (&argc, &argv);
+
+  g_object_set (gegl_config (), "threads", 4, NULL);
+
+  format = babl_format ("Y u8");
+
+  for (y = 0; y < HEIGHT; y++)
+    for (x = 0; x < WIDTH; x++)
+      pixels[y * WIDTH + x] = source_value (x, y);
+
+  source = g_object_new (GEGL_TYPE_BUFFER,
+                         "x",           0,
+                         "y",           0,
+                         "width",       WIDTH,
+                         "height",      HEIGHT,
+                         "tile-width",  64,
+                         "tile-height", 64,
+                         "format",      format,
+                         NULL);
+  gegl_buffer_set (source, NULL, 0, format, pixels, GEGL_AUTO_ROWSTRIDE);
+
+  if (!test_foreach (source, 48, 0, "aligned"))
+    result = FAILURE;
+  if (!test_foreach (source, 64, 10, "shifted"))
+    result = FAILURE;
+
+  g_object_unref (source);
+  g_free (pixels);
+  gegl_exit ();
+
+  return result;
+}
@@ -0,0 +1,99 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <string.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define TILE_WIDTH  64
+#define TILE_HEIGHT 32
+#define WIDTH       (TILE_WIDTH * 4)
+#define HEIGHT      (TILE_HEIGHT * 4)
+
+static int
+test_buffer_set_color (void)
+{
+  gint           result = SUCCESS;
+  const Babl    *format = babl_format ("Y u8");
+  GeglRectangle  fill_rect = {TILE_WIDTH / 2, TILE_HEIGHT / 2,
+                              TILE_WIDTH * 3, TILE_HEIGHT * 3};
+  GeglRectangle  poke_rect = {TILE_WIDTH * 2, TILE_HEIGHT * 2, 1, 1};
+  guchar         pixels[WIDTH * HEIGHT];
+  guchar         value = 200;
+  guchar         poke = 7;
+  GeglBuffer    *buffer;
+  gint           x, y;
+
+  buffer = g_object_new (GEGL_TYPE_BUFFER,
+                         "x",           0,
+                         "y",           0,
+                         "width",       WIDTH,
+                         "height",      HEIGHT,
+                         "tile-width",  TILE_WIDTH,
+                         "tile-height", TILE_HEIGHT,
+                         "format",      format,
+                         NULL);
+
+  /* covers whole tiles, which get shared, and partial ones around them */
+  gegl_buffer_set_color_from_pixel (buffer, &fill_rect, &value, format);
+
+  /* writing to one of the shared tiles must leave the others alone */
+  gegl_buffer_set (buffer, &poke_rect, 0, format, &poke, GEGL_AUTO_ROWSTRIDE);
+
+  gegl_buffer_get (buffer, NULL, 1.0, format, pixels,
+                   GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+  for (y = 0; y < HEIGHT && result == SUCCESS; y++)
+    for (x = 0; x < WIDTH; x++)
+      {
+        guchar expected = 0;
+
+        if (x == poke_rect.x && y == poke_rect.y)
+          expected = poke;
+        else if (x >= fill_rect.x && x < fill_rect.x + fill_rect.width &&
+                 y >= fill_rect.y && y < fill_rect.y + fill_rect.height)
+          expected = value;
+
+        if (pixels[y * WIDTH + x] != expected)
+          {
+            g_printerr ("test-buffer-set-color: pixel %d,%d is %d, expected %d\n",
+                        x, y, pixels[y * WIDTH + x], expected);
+            result = FAILURE;
+            break;
+          }
+      }
+
+  g_object_unref (buffer);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  gint result = SUCCESS;
+
+  gegl_init (&argc, &argv);
+
+  if (result == SUCCESS)
+    result = test_buffer_set_color ();
+
+  gegl_exit ();
+
+  return result;
+}
@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <string.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define TILE_WIDTH  64
+#define TILE_HEIGHT 32
+
+static int
+test_buffer_tile_access (void)
+{
+  gint           result = SUCCESS;
+  const Babl    *format = babl_format ("Y u8");
+  GeglRectangle  tile_rect = {TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, TILE_HEIGHT};
+  guchar         pixels[TILE_WIDTH * TILE_HEIGHT];
+  GeglBuffer    *buffer;
+  guchar        *data;
+  gint           rowstride;
+  gint           i;
+
+  buffer = g_object_new (GEGL_TYPE_BUFFER,
+                         "x",           0,
+                         "y",           0,
+                         "width",       TILE_WIDTH * 4,
+                         "height",      TILE_HEIGHT * 4,
+                         "tile-width",  TILE_WIDTH,
+                         "tile-height", TILE_HEIGHT,
+                         "format",      format,
+                         NULL);
+
+  /* requests that don't map to exactly one tile are refused */
+  if (gegl_buffer_tile_open (buffer, GEGL_RECTANGLE (1, 0, TILE_WIDTH, TILE_HEIGHT),
+                             format, GEGL_ACCESS_READ, NULL) ||
+      gegl_buffer_tile_open (buffer, &tile_rect, babl_format ("Y float"),
+                             GEGL_ACCESS_READ, NULL))
+    {
+      g_printerr ("test-buffer-tile-access: incompatible request granted\n");
+      result = FAILURE;
+    }
+
+  data = gegl_buffer_tile_open (buffer, &tile_rect, format,
+                                GEGL_ACCESS_WRITE, &rowstride);
+  if (!data || rowstride != TILE_WIDTH)
+    {
+      g_printerr ("test-buffer-tile-access: tile aligned request refused\n");
+      g_object_unref (buffer);
+      return FAILURE;
+    }
+
+  for (i = 0; i < TILE_WIDTH * TILE_HEIGHT; i++)
+    data[i] = i % 251;
+  gegl_buffer_tile_close (buffer, data);
+
+  gegl_buffer_get (buffer, &tile_rect, 1.0, format, pixels,
+                   GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+  for (i = 0; i < TILE_WIDTH * TILE_HEIGHT; i++)
+    if (pixels[i] != i % 251)
+      {
+        g_printerr ("test-buffer-tile-access: pixel %d mismatch\n", i);
+        result = FAILURE;
+        break;
+      }
+
+  g_object_unref (buffer);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  gint result = SUCCESS;
+
+  gegl_init (&argc, &argv);
+
+  if (result == SUCCESS)
+    result = test_buffer_tile_access ();
+
+  gegl_exit ();
+
+  return result;
+}
@@ -0,0 +1,120 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define SIZE     256
+
+/* gegl:color-exchange starts its output sharing the tiles of its input,
+ * which is a user provided buffer here, and only writes the tiles with
+ * pixels it changes. Check that the output is right and the input left
+ * untouched.
+ */
+
+static gboolean
+check_pixels (const gchar  *what,
+              const gfloat *pixels,
+              gfloat        inside,
+              gfloat        outside)
+{
+  gint x, y, c;
+
+  for (y = 0; y < SIZE; y++)
+    for (x = 0; x < SIZE; x++)
+      {
+        gboolean in_square = x >= 10 && x < 30 && y >= 10 && y < 30;
+        gfloat   expected  = in_square ? inside : outside;
+
+        for (c = 0; c < 3; c++)
+          if (pixels[(y * SIZE + x) * 4 + c] != expected)
+            {
+              g_printerr ("%s: pixel %d,%d channel %d is %f, expected %f\n",
+                          what, x, y, c, pixels[(y * SIZE + x) * 4 + c],
+                          expected);
+              return FALSE;
+            }
+      }
+
+  return TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+  int         result = SUCCESS;
+  const Babl *format;
+  GeglBuffer *buffer;
+  GeglColor  *gray, *white, *black;
+  GeglNode   *graph, *source, *exchange;
+  gfloat     *pixels;
+
+  gegl_init (&argc, &argv);
+
+  format = babl_format ("R'G'B'A float");
+  pixels = g_new (gfloat, SIZE * SIZE * 4);
+
+  gray  = gegl_color_new (NULL);
+  white = gegl_color_new (NULL);
+  black = gegl_color_new (NULL);
+  gegl_color_set_pixel (gray, babl_format ("R'G'B'A double"),
+                        (gdouble[]) { 0.5, 0.5, 0.5, 1.0 });
+  gegl_color_set_pixel (white, babl_format ("R'G'B'A double"),
+                        (gdouble[]) { 0.75, 0.75, 0.75, 1.0 });
+  gegl_color_set_pixel (black, babl_format ("R'G'B'A double"),
+                        (gdouble[]) { 0.0, 0.0, 0.0, 1.0 });
+
+  buffer = gegl_buffer_new (GEGL_RECTANGLE (0, 0, SIZE, SIZE), format);
+  gegl_buffer_set_color (buffer, GEGL_RECTANGLE (0, 0, SIZE, SIZE), white);
+  gegl_buffer_set_color (buffer, GEGL_RECTANGLE (10, 10, 20, 20), gray);
+
+  graph = gegl_node_new ();
+  source = gegl_node_new_child (graph,
+                                "operation", "gegl:buffer-source",
+                                "buffer", buffer,
+                                NULL);
+  exchange = gegl_node_new_child (graph,
+                                  "operation", "gegl:color-exchange",
+                                  "from-color", gray,
+                                  "to-color", black,
+                                  "red-threshold", 0.1,
+                                  "green-threshold", 0.1,
+                                  "blue-threshold", 0.1,
+                                  NULL);
+  gegl_node_link (source, exchange);
+
+  gegl_node_blit (exchange, 1.0, GEGL_RECTANGLE (0, 0, SIZE, SIZE),
+                  format, pixels, GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+  if (!check_pixels ("output", pixels, 0.0, 0.75))
+    result = FAILURE;
+
+  gegl_buffer_get (buffer, GEGL_RECTANGLE (0, 0, SIZE, SIZE), 1.0,
+                   format, pixels, GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+  if (!check_pixels ("input", pixels, 0.5, 0.75))
+    result = FAILURE;
+
+  g_object_unref (graph);
+  g_object_unref (buffer);
+  g_object_unref (gray);
+  g_object_unref (white);
+  g_object_unref (black);
+  g_free (pixels);
+  gegl_exit ();
+
+  return result;
+}
@@ -0,0 +1,136 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define SIZE     16
+
+/* Renders a graph of no-op nodes and point filters fed by a constant
+ * color, which GEGL computes without processing the individual nodes.
+ */
+
+static gboolean
+check_pixels (const gchar  *what,
+              const gfloat *pixels,
+              gint          n_pixels,
+              const gfloat *expected)
+{
+  gint i, c;
+
+  for (i = 0; i < n_pixels; i++)
+    for (c = 0; c < 4; c++)
+      if (fabsf (pixels[i * 4 + c] - expected[c]) > 1e-5)
+        {
+          g_printerr ("%s: pixel %d channel %d is %f, expected %f\n",
+                      what, i, c, pixels[i * 4 + c], expected[c]);
+          return FALSE;
+        }
+
+  return TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+  int         result   = SUCCESS;
+  gfloat      pixels[SIZE * SIZE * 4];
+  gfloat      color_pixel[4] = { 0.25, 0.5, 0.75, 1.0 };
+  gfloat      folded[4];
+  gfloat      empty[4] = { 0.0, 0.0, 0.0, 0.0 };
+  GeglColor  *value;
+  GeglNode   *graph, *color, *crop, *nop_bc, *opacity, *translate, *bc;
+  gint        c;
+
+  gegl_init (&argc, &argv);
+
+  value = gegl_color_new (NULL);
+  gegl_color_set_rgba (value, color_pixel[0], color_pixel[1],
+                       color_pixel[2], color_pixel[3]);
+
+  graph = gegl_node_new ();
+  color = gegl_node_new_child (graph,
+                               "operation", "gegl:color",
+                               "value", value,
+                               NULL);
+  nop_bc = gegl_node_new_child (graph,
+                                "operation", "gegl:brightness-contrast",
+                                NULL);
+  opacity = gegl_node_new_child (graph,
+                                 "operation", "gegl:opacity",
+                                 NULL);
+  translate = gegl_node_new_child (graph,
+                                   "operation", "gegl:translate",
+                                   NULL);
+  bc = gegl_node_new_child (graph,
+                            "operation", "gegl:brightness-contrast",
+                            "brightness", 0.1,
+                            "contrast", 2.0,
+                            NULL);
+  crop = gegl_node_new_child (graph,
+                              "operation", "gegl:crop",
+                              "width", (gdouble) SIZE,
+                              "height", (gdouble) SIZE,
+                              NULL);
+
+  gegl_node_link_many (color, nop_bc, opacity, translate, bc, crop, NULL);
+
+  for (c = 0; c < 3; c++)
+    folded[c] = (color_pixel[c] - 0.5) * 2.0 + 0.1 + 0.5;
+  folded[3] = color_pixel[3];
+
+  /* the chain of no-ops hands on the color */
+  memset (pixels, 0, sizeof (pixels));
+  gegl_node_blit (translate, 1.0, GEGL_RECTANGLE (0, 0, SIZE, SIZE),
+                  babl_format ("RGBA float"), pixels,
+                  GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+  if (!check_pixels ("no-ops", pixels, SIZE * SIZE, color_pixel))
+    result = FAILURE;
+
+  /* the last point filter is folded into a new constant */
+  memset (pixels, 0, sizeof (pixels));
+  gegl_node_blit (crop, 1.0, GEGL_RECTANGLE (0, 0, SIZE, SIZE),
+                  babl_format ("RGBA float"), pixels,
+                  GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+  if (!check_pixels ("folded", pixels, SIZE * SIZE, folded))
+    result = FAILURE;
+
+  /* ...that gets cropped like any other data */
+  memset (pixels, 0xff, sizeof (pixels));
+  gegl_node_blit (crop, 1.0, GEGL_RECTANGLE (SIZE, SIZE, SIZE, SIZE),
+                  babl_format ("RGBA float"), pixels,
+                  GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+  if (!check_pixels ("outside crop", pixels, SIZE * SIZE, empty))
+    result = FAILURE;
+
+  /* once translate moves the data, everything after it is processed again */
+  gegl_node_set (translate, "x", 1.0, NULL);
+  memset (pixels, 0, sizeof (pixels));
+  gegl_node_blit (crop, 1.0, GEGL_RECTANGLE (0, 0, SIZE, SIZE),
+                  babl_format ("RGBA float"), pixels,
+                  GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+  if (!check_pixels ("translated", pixels, SIZE * SIZE, folded))
+    result = FAILURE;
+
+  g_object_unref (graph);
+  g_object_unref (value);
+  gegl_exit ();
+
+  return result;
+}
@@ -0,0 +1,186 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define SIZE     256
+
+/* Composites a layer that is transparent but for a small square over a
+ * gradient, and thresholds a flat image with a darker square. Most chunks
+ * are decided by the classify method of the operations instead of being
+ * processed, the results have to be the same.
+ */
+
+static gboolean
+in_square (gint x,
+           gint y)
+{
+  return x >= 10 && x < 30 && y >= 10 && y < 30;
+}
+
+static gboolean
+check_pixel (const gchar  *what,
+             gint          x,
+             gint          y,
+             const gfloat *pixel,
+             const gfloat *expected)
+{
+  gint c;
+
+  for (c = 0; c < 4; c++)
+    if (fabsf (pixel[c] - expected[c]) > 1e-5)
+      {
+        g_printerr ("%s: pixel %d,%d channel %d is %f, expected %f\n",
+                    what, x, y, c, pixel[c], expected[c]);
+        return FALSE;
+      }
+
+  return TRUE;
+}
+
+static gboolean
+test_over (void)
+{
+  const Babl *format = babl_format ("RGBA float");
+  gfloat     *pixels = g_new (gfloat, SIZE * SIZE * 4);
+  gfloat      red[4] = { 1.0, 0.0, 0.0, 1.0 };
+  gboolean    result = TRUE;
+  GeglBuffer *background, *layer;
+  GeglColor  *color;
+  GeglNode   *graph, *bottom, *top, *over;
+  gint        x, y;
+
+  for (y = 0; y < SIZE; y++)
+    for (x = 0; x < SIZE; x++)
+      {
+        gfloat *pixel = pixels + (y * SIZE + x) * 4;
+
+        pixel[0] = x / (gfloat) SIZE;
+        pixel[1] = y / (gfloat) SIZE;
+        pixel[2] = 0.5;
+        pixel[3] = 1.0;
+      }
+
+  background = gegl_buffer_new (GEGL_RECTANGLE (0, 0, SIZE, SIZE), format);
+  gegl_buffer_set (background, NULL, 0, format, pixels, GEGL_AUTO_ROWSTRIDE);
+
+  color = gegl_color_new ("red");
+  layer = gegl_buffer_new (GEGL_RECTANGLE (0, 0, SIZE, SIZE), format);
+  gegl_buffer_set_color (layer, GEGL_RECTANGLE (10, 10, 20, 20), color);
+
+  graph = gegl_node_new ();
+  bottom = gegl_node_new_child (graph,
+                                "operation", "gegl:buffer-source",
+                                "buffer", background,
+                                NULL);
+  top = gegl_node_new_child (graph,
+                             "operation", "gegl:buffer-source",
+                             "buffer", layer,
+                             NULL);
+  over = gegl_node_new_child (graph,
+                              "operation", "gegl:over",
+                              NULL);
+  gegl_node_link (bottom, over);
+  gegl_node_connect_to (top, "output", over, "aux");
+
+  gegl_node_blit (over, 1.0, GEGL_RECTANGLE (0, 0, SIZE, SIZE),
+                  format, pixels, GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+
+  for (y = 0; y < SIZE && result; y++)
+    for (x = 0; x < SIZE && result; x++)
+      {
+        gfloat below[4] = { x / (gfloat) SIZE, y / (gfloat) SIZE, 0.5, 1.0 };
+
+        result = check_pixel ("over", x, y, pixels + (y * SIZE + x) * 4,
+                              in_square (x, y) ? red : below);
+      }
+
+  g_object_unref (graph);
+  g_object_unref (background);
+  g_object_unref (layer);
+  g_object_unref (color);
+  g_free (pixels);
+
+  return result;
+}
+
+static gboolean
+test_threshold (void)
+{
+  const Babl *format = babl_format ("RGBA float");
+  gfloat     *pixels = g_new (gfloat, SIZE * SIZE * 4);
+  gfloat      white[4] = { 1.0, 1.0, 1.0, 1.0 };
+  gfloat      black[4] = { 0.0, 0.0, 0.0, 1.0 };
+  gboolean    result = TRUE;
+  GeglBuffer *buffer;
+  GeglColor  *light, *dark;
+  GeglNode   *graph, *source, *threshold;
+  gint        x, y;
+
+  light = gegl_color_new ("rgb(0.75, 0.75, 0.75)");
+  dark  = gegl_color_new ("rgb(0.25, 0.25, 0.25)");
+
+  buffer = gegl_buffer_new (GEGL_RECTANGLE (0, 0, SIZE, SIZE), format);
+  gegl_buffer_set_color (buffer, GEGL_RECTANGLE (0, 0, SIZE, SIZE), light);
+  gegl_buffer_set_color (buffer, GEGL_RECTANGLE (10, 10, 20, 20), dark);
+
+  graph = gegl_node_new ();
+  source = gegl_node_new_child (graph,
+                                "operation", "gegl:buffer-source",
+                                "buffer", buffer,
+                                NULL);
+  threshold = gegl_node_new_child (graph,
+                                   "operation", "gegl:threshold",
+                                   "value", 0.5,
+                                   NULL);
+  gegl_node_link (source, threshold);
+
+  gegl_node_blit (threshold, 1.0, GEGL_RECTANGLE (0, 0, SIZE, SIZE),
+                  format, pixels, GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+
+  for (y = 0; y < SIZE && result; y++)
+    for (x = 0; x < SIZE && result; x++)
+      result = check_pixel ("threshold", x, y, pixels + (y * SIZE + x) * 4,
+                            in_square (x, y) ? black : white);
+
+  g_object_unref (graph);
+  g_object_unref (buffer);
+  g_object_unref (light);
+  g_object_unref (dark);
+  g_free (pixels);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  int result = SUCCESS;
+
+  gegl_init (&argc, &argv);
+
+  if (!test_over ())
+    result = FAILURE;
+  if (!test_threshold ())
+    result = FAILURE;
+
+  gegl_exit ();
+
+  return result;
+}
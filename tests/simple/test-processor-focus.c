@@ -0,0 +1,160 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define SIZE     512
+
+/* Renders white into a buffer a chunk at a time, with a viewport and a
+ * focus point set on the processor. The first chunk has to cover the
+ * focus, every following one may not be closer to it than the one before,
+ * and nothing outside the viewport may be rendered.
+ */
+
+static gboolean
+in_rect (const GeglRectangle *rect,
+         gint                 x,
+         gint                 y)
+{
+  return x >= rect->x && x < rect->x + rect->width &&
+         y >= rect->y && y < rect->y + rect->height;
+}
+
+int main(int argc, char *argv[])
+{
+  int            result   = SUCCESS;
+  GeglRectangle  canvas   = { 0, 0, SIZE, SIZE };
+  GeglRectangle  viewport = { 128, 64, 256, 256 };
+  gint           focus_x  = 300;
+  gint           focus_y  = 200;
+  const Babl    *format;
+  guchar        *pixels   = g_new (guchar, SIZE * SIZE);
+  guchar        *rendered = g_new0 (guchar, SIZE * SIZE);
+  gint64         last_distance = -1;
+  gint           steps = 0;
+  gboolean       more_work;
+  GeglBuffer    *buffer;
+  GeglColor     *white;
+  GeglNode      *graph, *color, *sink;
+  GeglProcessor *processor;
+  gint           x, y;
+
+  gegl_init (&argc, &argv);
+
+  format = babl_format ("Y u8");
+  buffer = gegl_buffer_new (&canvas, format);
+  white  = gegl_color_new ("white");
+
+  graph = gegl_node_new ();
+  color = gegl_node_new_child (graph,
+                               "operation", "gegl:color",
+                               "value", white,
+                               NULL);
+  sink = gegl_node_new_child (graph,
+                              "operation", "gegl:write-buffer",
+                              "buffer", buffer,
+                              NULL);
+  gegl_node_link (color, sink);
+
+  processor = gegl_node_new_processor (sink, &canvas);
+  gegl_processor_set_viewport (processor, &viewport);
+  gegl_processor_set_focus (processor, focus_x, focus_y);
+
+  do
+    {
+      GeglRectangle chunk = { 0, 0, 0, 0 };
+      gint          x1 = G_MININT, y1 = G_MININT;
+
+      more_work = gegl_processor_work (processor, NULL);
+
+      gegl_buffer_get (buffer, &canvas, 1.0, format, pixels,
+                       GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+      /* the bounding box of what this step rendered */
+      chunk.x = G_MAXINT;
+      chunk.y = G_MAXINT;
+
+      for (y = 0; y < SIZE; y++)
+        for (x = 0; x < SIZE; x++)
+          if (pixels[y * SIZE + x] && !rendered[y * SIZE + x])
+            {
+              rendered[y * SIZE + x] = 1;
+              chunk.x = MIN (chunk.x, x);
+              chunk.y = MIN (chunk.y, y);
+              x1 = MAX (x1, x + 1);
+              y1 = MAX (y1, y + 1);
+            }
+
+      if (x1 != G_MININT)
+        {
+          gint64 dx, dy, distance;
+
+          chunk.width  = x1 - chunk.x;
+          chunk.height = y1 - chunk.y;
+
+          if (!gegl_rectangle_contains (&viewport, &chunk))
+            {
+              g_printerr ("chunk %d,%d %dx%d is outside of the viewport\n",
+                          chunk.x, chunk.y, chunk.width, chunk.height);
+              result = FAILURE;
+            }
+
+          if (last_distance < 0 && !in_rect (&chunk, focus_x, focus_y))
+            {
+              g_printerr ("first chunk %d,%d %dx%d misses the focus\n",
+                          chunk.x, chunk.y, chunk.width, chunk.height);
+              result = FAILURE;
+            }
+
+          /* doubled coordinates, like the processor */
+          dx = (gint64) chunk.x * 2 + chunk.width - focus_x * 2;
+          dy = (gint64) chunk.y * 2 + chunk.height - focus_y * 2;
+          distance = dx * dx + dy * dy;
+
+          if (distance < last_distance)
+            {
+              g_printerr ("chunk %d,%d %dx%d is rendered after farther ones\n",
+                          chunk.x, chunk.y, chunk.width, chunk.height);
+              result = FAILURE;
+            }
+
+          last_distance = distance;
+        }
+    }
+  while (more_work && ++steps < 10000 && result == SUCCESS);
+
+  for (y = 0; y < SIZE && result == SUCCESS; y++)
+    for (x = 0; x < SIZE; x++)
+      if (!!rendered[y * SIZE + x] != in_rect (&viewport, x, y))
+        {
+          g_printerr ("pixel %d,%d is %s\n", x, y,
+                      rendered[y * SIZE + x] ? "rendered" : "missing");
+          result = FAILURE;
+          break;
+        }
+
+  g_object_unref (processor);
+  g_object_unref (graph);
+  g_object_unref (white);
+  g_object_unref (buffer);
+  g_free (pixels);
+  g_free (rendered);
+  gegl_exit ();
+
+  return result;
+}
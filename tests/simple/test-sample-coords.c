@@ -0,0 +1,211 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define SIZE     100
+
+/* gegl_buffer_sample_coords () has to give, for every output pixel, what
+ * gegl_buffer_sample () gives at the pixel's source coordinates, and
+ * transparency for non-finite ones. Pixels mapping onto themselves are
+ * copied when asked for, whole blocks of them and single ones. At level 1
+ * the output is written at that level and sampled from it. The output
+ * has small tiles, so that blocks are cut at tile edges.
+ */
+
+typedef struct
+{
+  gboolean exact;
+  gboolean with_scale;
+} Mapping;
+
+static gboolean
+is_exact (gint x,
+          gint y)
+{
+  return x < 40 || (x * 7 + y * 3) % 11 == 0;
+}
+
+static void
+source_coords (const Mapping *mapping,
+               gint           x,
+               gint           y,
+               gdouble       *u,
+               gdouble       *v)
+{
+  if (mapping->exact && is_exact (x, y))
+    {
+      *u = x;
+      *v = y;
+    }
+  else if ((x + y) % 37 == 0)
+    {
+      *u = NAN;
+      *v = y;
+    }
+  else
+    {
+      *u = x + 7.0 * sin (y / 5.0) + 0.5;
+      *v = y * 0.9 + 3.2;
+    }
+}
+
+static void
+scale_at (gint         x,
+          gint         y,
+          GeglMatrix2 *scale)
+{
+  scale->coeff[0][0] = 1.0 + x / 50.0;
+  scale->coeff[0][1] = 0.2;
+  scale->coeff[1][0] = -0.1;
+  scale->coeff[1][1] = 1.0 + y / 40.0;
+}
+
+static void
+mapping_coords (const GeglRectangle *roi,
+                gdouble             *coords,
+                GeglMatrix2         *scale,
+                gpointer             user_data)
+{
+  const Mapping *mapping = user_data;
+  gint           x, y;
+
+  for (y = roi->y; y < roi->y + roi->height; y++)
+    for (x = roi->x; x < roi->x + roi->width; x++)
+      {
+        source_coords (mapping, x, y, &coords[0], &coords[1]);
+        coords += 2;
+
+        if (scale)
+          scale_at (x, y, scale++);
+      }
+}
+
+static gboolean
+test_sample_coords (GeglBuffer      *input,
+                    GeglSamplerType  type,
+                    gint             level,
+                    gboolean         exact,
+                    gboolean         with_scale,
+                    const gchar     *name)
+{
+  const Babl   *format  = babl_format ("RaGaBaA float");
+  const gint    factor  = 1 << level;
+  const gint    size    = SIZE / factor;
+  Mapping       mapping = { exact, with_scale };
+  gfloat       *pixels  = g_new (gfloat, size * size * 4);
+  gboolean      result  = TRUE;
+  GeglSampler  *sampler;
+  GeglBuffer   *output;
+  gint          x, y, c;
+
+  output = g_object_new (GEGL_TYPE_BUFFER,
+                         "x",           0,
+                         "y",           0,
+                         "width",       SIZE,
+                         "height",      SIZE,
+                         "tile-width",  48,
+                         "tile-height", 40,
+                         "format",      format,
+                         NULL);
+
+  gegl_buffer_sample_coords (input, output, GEGL_RECTANGLE (0, 0, SIZE, SIZE),
+                             level, format, type, GEGL_ABYSS_NONE,
+                             with_scale, exact, mapping_coords, &mapping);
+
+  gegl_buffer_get (output, GEGL_RECTANGLE (0, 0, size, size), 1.0 / factor,
+                   format, pixels, GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+
+  sampler = gegl_buffer_sampler_new_at_level (input, format, type, level);
+
+  for (y = 0; y < size && result; y++)
+    for (x = 0; x < size && result; x++)
+      {
+        gfloat      expected[4] = { 0.0, 0.0, 0.0, 0.0 };
+        gfloat     *pixel = pixels + (y * size + x) * 4;
+        GeglMatrix2 scale;
+        gdouble     u, v;
+
+        source_coords (&mapping, x, y, &u, &v);
+        scale_at (x, y, &scale);
+
+        if (exact && is_exact (x, y))
+          gegl_buffer_get (input, GEGL_RECTANGLE (x, y, 1, 1), 1.0 / factor,
+                           format, expected, GEGL_AUTO_ROWSTRIDE,
+                           GEGL_ABYSS_NONE);
+        else if (isfinite (u) && isfinite (v))
+          gegl_sampler_get (sampler, u * factor, v * factor,
+                            with_scale ? &scale : NULL, expected,
+                            GEGL_ABYSS_NONE);
+
+        for (c = 0; c < 4; c++)
+          if (fabsf (pixel[c] - expected[c]) > 1e-5)
+            {
+              g_printerr ("%s: pixel %d,%d channel %d is %f, expected %f\n",
+                          name, x, y, c, pixel[c], expected[c]);
+              result = FALSE;
+              break;
+            }
+      }
+
+  g_object_unref (sampler);
+  g_object_unref (output);
+  g_free (pixels);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  int         result = SUCCESS;
+  const Babl *format = babl_format ("RaGaBaA float");
+  gfloat     *pixels = g_new (gfloat, SIZE * SIZE * 4);
+  guint32     seed   = 1;
+  GeglBuffer *input;
+  gint        i;
+
+  gegl_init (&argc, &argv);
+
+  for (i = 0; i < SIZE * SIZE; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      pixels[i * 4 + 0] = ((seed >> 16) & 0xff) / 255.0;
+      pixels[i * 4 + 1] = ((seed >> 8) & 0xff) / 255.0;
+      pixels[i * 4 + 2] = (seed & 0xff) / 255.0;
+      pixels[i * 4 + 3] = ((seed >> 24) & 0xff) / 255.0;
+    }
+
+  input = gegl_buffer_new (GEGL_RECTANGLE (0, 0, SIZE, SIZE), format);
+  gegl_buffer_set (input, NULL, 0, format, pixels, GEGL_AUTO_ROWSTRIDE);
+
+  if (!test_sample_coords (input, GEGL_SAMPLER_LINEAR, 0, FALSE, FALSE, "linear") ||
+      !test_sample_coords (input, GEGL_SAMPLER_CUBIC,  0, FALSE, FALSE, "cubic") ||
+      !test_sample_coords (input, GEGL_SAMPLER_NOHALO, 0, FALSE, TRUE,  "nohalo") ||
+      !test_sample_coords (input, GEGL_SAMPLER_CUBIC,  0, TRUE,  FALSE, "cubic, exact") ||
+      !test_sample_coords (input, GEGL_SAMPLER_LINEAR, 1, FALSE, FALSE, "linear, level 1") ||
+      !test_sample_coords (input, GEGL_SAMPLER_LINEAR, 1, TRUE,  FALSE, "linear, level 1, exact"))
+    result = FAILURE;
+
+  g_object_unref (input);
+  g_free (pixels);
+  gegl_exit ();
+
+  return result;
+}
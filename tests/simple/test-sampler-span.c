@@ -0,0 +1,133 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+#define WIDTH    100
+#define HEIGHT   80
+#define MAX_SPAN 300
+
+/* Spans have to give what gegl_sampler_get () gives at each of their
+ * points. They are longer than GEGL_SAMPLER_SPAN_CHUNK and start, end or
+ * run entirely in the abyss around the buffer.
+ */
+
+typedef struct
+{
+  gdouble x, y;
+  gdouble dx, dy;
+  gint    n_samples;
+} Span;
+
+static const Span spans[] =
+{
+  /* from the top left abyss into the buffer */
+  { -5.3, -2.7, 0.37, 0.11, 200 },
+  /* out through the bottom right edge */
+  { 90.2, 70.6, 0.13, 0.05, 150 },
+  /* right to left, along the top edge */
+  { 104.5, 0.25, -0.5, 0.0, MAX_SPAN },
+  /* on pixel centers, along the left edge */
+  { 0.5, -10.5, 0.0, 1.0, 100 },
+  /* entirely in the abyss */
+  { -20.0, 90.0, 0.7, 0.0, 70 },
+  /* a short one */
+  { 10.1, 10.2, 0.9, 0.3, 5 }
+};
+
+static gboolean
+test_sampler (GeglBuffer      *buffer,
+              GeglSamplerType  type,
+              const gchar     *name,
+              GeglAbyssPolicy  abyss)
+{
+  const Babl  *format = babl_format ("RaGaBaA float");
+  GeglSampler *sampler = gegl_buffer_sampler_new (buffer, format, type);
+  gfloat       span[MAX_SPAN * 4];
+  gboolean     result = TRUE;
+  gint         s, i, c;
+
+  for (s = 0; s < (gint) G_N_ELEMENTS (spans) && result; s++)
+    {
+      const Span *sp = &spans[s];
+
+      gegl_sampler_get_span (sampler, sp->x, sp->y, sp->dx, sp->dy, NULL,
+                             span, sp->n_samples, abyss);
+
+      for (i = 0; i < sp->n_samples && result; i++)
+        {
+          gfloat expected[4];
+
+          gegl_sampler_get (sampler, sp->x + i * sp->dx, sp->y + i * sp->dy,
+                            NULL, expected, abyss);
+
+          for (c = 0; c < 4; c++)
+            if (fabsf (span[i * 4 + c] - expected[c]) > 1e-5)
+              {
+                g_printerr ("%s, abyss %d, span %d: sample %d channel %d "
+                            "is %f, expected %f\n",
+                            name, abyss, s, i, c, span[i * 4 + c],
+                            expected[c]);
+                result = FALSE;
+                break;
+              }
+        }
+    }
+
+  g_object_unref (sampler);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  int         result = SUCCESS;
+  const Babl *format = babl_format ("RaGaBaA float");
+  gfloat     *pixels = g_new (gfloat, WIDTH * HEIGHT * 4);
+  guint32     seed   = 1;
+  GeglBuffer *buffer;
+  gint        i;
+
+  gegl_init (&argc, &argv);
+
+  for (i = 0; i < WIDTH * HEIGHT; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      pixels[i * 4 + 0] = ((seed >> 16) & 0xff) / 255.0;
+      pixels[i * 4 + 1] = ((seed >> 8) & 0xff) / 255.0;
+      pixels[i * 4 + 2] = (seed & 0xff) / 255.0;
+      pixels[i * 4 + 3] = ((seed >> 24) & 0xff) / 255.0;
+    }
+
+  buffer = gegl_buffer_new (GEGL_RECTANGLE (0, 0, WIDTH, HEIGHT), format);
+  gegl_buffer_set (buffer, NULL, 0, format, pixels, GEGL_AUTO_ROWSTRIDE);
+
+  if (!test_sampler (buffer, GEGL_SAMPLER_LINEAR, "linear", GEGL_ABYSS_NONE) ||
+      !test_sampler (buffer, GEGL_SAMPLER_LINEAR, "linear", GEGL_ABYSS_CLAMP) ||
+      !test_sampler (buffer, GEGL_SAMPLER_CUBIC,  "cubic",  GEGL_ABYSS_NONE) ||
+      !test_sampler (buffer, GEGL_SAMPLER_CUBIC,  "cubic",  GEGL_ABYSS_CLAMP))
+    result = FAILURE;
+
+  g_object_unref (buffer);
+  g_free (pixels);
+  gegl_exit ();
+
+  return result;
+}
@@ -0,0 +1,544 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "gegl.h"
+
+#define SUCCESS  0
+#define FAILURE -1
+
+/* The transform operations pick specialised paths for some matrices and
+ * samplers. Whatever path is taken, each output pixel has to be what the
+ * sampler gives at the pixel's center mapped back to the input, within a
+ * tolerance that is tight for the exact paths.
+ */
+
+#define SMOOTH_SIZE 1024
+
+/* opaque noise, the hardest input for resampling shortcuts */
+static GeglBuffer *
+noise_buffer (gint size)
+{
+  const Babl *format = babl_format ("RaGaBaA float");
+  gfloat     *pixels = g_new (gfloat, size * size * 4);
+  guint32     seed   = 1;
+  GeglBuffer *buffer;
+  gint        i;
+
+  for (i = 0; i < size * size; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      pixels[i * 4 + 0] = ((seed >> 16) & 0xff) / 255.0;
+      pixels[i * 4 + 1] = ((seed >> 8) & 0xff) / 255.0;
+      pixels[i * 4 + 2] = (seed & 0xff) / 255.0;
+      pixels[i * 4 + 3] = 1.0;
+    }
+
+  buffer = gegl_buffer_new (GEGL_RECTANGLE (0, 0, size, size), format);
+  gegl_buffer_set (buffer, NULL, 0, format, pixels, GEGL_AUTO_ROWSTRIDE);
+  g_free (pixels);
+
+  return buffer;
+}
+
+/* opaque and varying slowly, so that any filter footprint of a few dozen
+ * pixels averages it to about the value at its center
+ */
+static GeglBuffer *
+smooth_buffer (void)
+{
+  const Babl *format = babl_format ("RaGaBaA float");
+  gfloat     *pixels = g_new (gfloat, SMOOTH_SIZE * SMOOTH_SIZE * 4);
+  GeglBuffer *buffer;
+  gint        x, y;
+
+  for (y = 0; y < SMOOTH_SIZE; y++)
+    for (x = 0; x < SMOOTH_SIZE; x++)
+      {
+        gfloat *pixel = pixels + (y * SMOOTH_SIZE + x) * 4;
+
+        pixel[0] = 0.5 + 0.5 * sin (x / 197.0);
+        pixel[1] = 0.5 + 0.5 * cos (y / 211.0);
+        pixel[2] = (x + y) / (2.0 * SMOOTH_SIZE);
+        pixel[3] = 1.0;
+      }
+
+  buffer = gegl_buffer_new (GEGL_RECTANGLE (0, 0, SMOOTH_SIZE, SMOOTH_SIZE),
+                            format);
+  gegl_buffer_set (buffer, NULL, 0, format, pixels, GEGL_AUTO_ROWSTRIDE);
+  g_free (pixels);
+
+  return buffer;
+}
+
+/* Renders @source through gegl:transform with @matrix, given column major
+ * as the operation parses it, and compares the @out_size square at the
+ * origin with the sampler.
+ */
+static gboolean
+test_transform (const gchar     *what,
+                GeglBuffer      *source,
+                const gchar     *matrix,
+                GeglSamplerType  sampler,
+                gboolean         mipmap,
+                gint             out_size,
+                gdouble          tolerance)
+{
+  const Babl  *format = babl_format ("RaGaBaA float");
+  gfloat      *output = g_new (gfloat, out_size * out_size * 4);
+  gboolean     result = TRUE;
+  GeglMatrix3  inverse;
+  GeglMatrix2  jacobian;
+  GeglNode    *graph, *input, *transform;
+  gint         x, y, c;
+
+  gegl_matrix3_parse_string (&inverse, matrix);
+  gegl_matrix3_invert (&inverse);
+
+  jacobian.coeff[0][0] = inverse.coeff[0][0];
+  jacobian.coeff[0][1] = inverse.coeff[0][1];
+  jacobian.coeff[1][0] = inverse.coeff[1][0];
+  jacobian.coeff[1][1] = inverse.coeff[1][1];
+
+  graph = gegl_node_new ();
+  input = gegl_node_new_child (graph,
+                               "operation", "gegl:buffer-source",
+                               "buffer", source,
+                               NULL);
+  transform = gegl_node_new_child (graph,
+                                   "operation", "gegl:transform",
+                                   "transform", matrix,
+                                   "sampler", sampler,
+                                   "mipmap", mipmap,
+                                   NULL);
+  gegl_node_link (input, transform);
+
+  gegl_node_blit (transform, 1.0, GEGL_RECTANGLE (0, 0, out_size, out_size),
+                  format, output, GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+
+  for (y = 0; y < out_size && result; y++)
+    for (x = 0; x < out_size && result; x++)
+      {
+        gfloat  expected[4];
+        gfloat *pixel = output + (y * out_size + x) * 4;
+        gdouble u = inverse.coeff[0][0] * (x + 0.5) +
+                    inverse.coeff[0][1] * (y + 0.5) + inverse.coeff[0][2];
+        gdouble v = inverse.coeff[1][0] * (x + 0.5) +
+                    inverse.coeff[1][1] * (y + 0.5) + inverse.coeff[1][2];
+        gdouble w = inverse.coeff[2][0] * (x + 0.5) +
+                    inverse.coeff[2][1] * (y + 0.5) + inverse.coeff[2][2];
+
+        gegl_buffer_sample (source, u / w, v / w, &jacobian, expected, format,
+                            sampler, GEGL_ABYSS_NONE);
+
+        for (c = 0; c < 4; c++)
+          if (fabsf (pixel[c] - expected[c]) > tolerance)
+            {
+              g_printerr ("%s: pixel %d,%d channel %d is %f, expected %f\n",
+                          what, x, y, c, pixel[c], expected[c]);
+              result = FALSE;
+              break;
+            }
+      }
+
+  g_object_unref (graph);
+  g_free (output);
+
+  return result;
+}
+
+/* Axis aligned scales are resampled in two separable passes. The factors
+ * keep the pixel centers off the input pixel boundaries, where nearest
+ * could round either way.
+ */
+static gboolean
+test_scale (void)
+{
+  GeglBuffer *source = noise_buffer (64);
+  gboolean    result = TRUE;
+
+#define UP   "matrix(1.37, 0.0, 0.0, 0.0, 1.37, 0.0, 0.0, 0.0, 1.0)"
+#define DOWN "matrix(0.61, 0.0, 0.0, 0.0, 0.61, 0.0, 0.0, 0.0, 1.0)"
+
+  if (!test_transform ("nearest up",   source, UP,   GEGL_SAMPLER_NEAREST, FALSE, 88, 1e-5) ||
+      !test_transform ("nearest down", source, DOWN, GEGL_SAMPLER_NEAREST, FALSE, 40, 1e-5) ||
+      !test_transform ("linear up",    source, UP,   GEGL_SAMPLER_LINEAR,  FALSE, 88, 1e-5) ||
+      !test_transform ("linear down",  source, DOWN, GEGL_SAMPLER_LINEAR,  FALSE, 40, 1e-5) ||
+      !test_transform ("cubic up",     source, UP,   GEGL_SAMPLER_CUBIC,   FALSE, 88, 1e-5) ||
+      !test_transform ("cubic down",   source, DOWN, GEGL_SAMPLER_CUBIC,   FALSE, 40, 1e-5))
+    result = FALSE;
+
+#undef UP
+#undef DOWN
+
+  g_object_unref (source);
+
+  return result;
+}
+
+/* At full quality, perspective transforms map each pixel center exactly.
+ * Below it they may approximate the mapping piecewise affinely, by at most
+ * 1/64 of a source pixel divided by the quality; with the linear sampler
+ * on values in [0, 1] that bounds the error of each channel to twice that.
+ */
+static gboolean
+test_perspective (void)
+{
+  GeglBuffer *source = noise_buffer (96);
+  gboolean    result = TRUE;
+
+#define PERSPECTIVE "matrix(1.0, 0.0, 0.002, 0.1, 1.0, 0.001, 5.0, 3.0, 1.0)"
+
+  if (!test_transform ("perspective", source, PERSPECTIVE,
+                       GEGL_SAMPLER_LINEAR, FALSE, 64, 1e-5))
+    result = FALSE;
+
+  g_object_set (gegl_config (), "quality", 0.5, NULL);
+
+  if (!test_transform ("perspective, quality 0.5", source, PERSPECTIVE,
+                       GEGL_SAMPLER_LINEAR, FALSE, 64,
+                       2 * (1.0 / 64) / 0.5 + 1e-5))
+    result = FALSE;
+
+  g_object_set (gegl_config (), "quality", 1.0, NULL);
+
+#undef PERSPECTIVE
+
+  g_object_unref (source);
+
+  return result;
+}
+
+/* Unless asked to go through the mipmap pyramid of the input, strong
+ * downscales sample the input directly, like any other transform. With
+ * the mipmap property set, the box filtered pyramid replaces the exact
+ * footprint of nohalo and lohalo, on smooth input that may only be off
+ * by a small fraction. The 1:20 downscale starts 100 input pixels into
+ * the input, away from where the two footprints see the abyss differently.
+ */
+static gboolean
+test_downscale (void)
+{
+  GeglBuffer *noise  = noise_buffer (512);
+  GeglBuffer *smooth = smooth_buffer ();
+  gboolean    result = TRUE;
+
+#define TENTH     "matrix(0.1, 0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.0, 1.0)"
+#define TWENTIETH "matrix(0.05, 0.0, 0.0, 0.0, 0.05, 0.0, -5.0, -5.0, 1.0)"
+
+  if (!test_transform ("nohalo 1:10", noise, TENTH,
+                       GEGL_SAMPLER_NOHALO, FALSE, 48, 1e-5) ||
+      !test_transform ("lohalo 1:10", noise, TENTH,
+                       GEGL_SAMPLER_LOHALO, FALSE, 48, 1e-5) ||
+      !test_transform ("mipmapped nohalo 1:20", smooth, TWENTIETH,
+                       GEGL_SAMPLER_NOHALO, TRUE, 40, 0.01) ||
+      !test_transform ("mipmapped lohalo 1:20", smooth, TWENTIETH,
+                       GEGL_SAMPLER_LOHALO, TRUE, 40, 0.01))
+    result = FALSE;
+
+#undef TENTH
+#undef TWENTIETH
+
+  g_object_unref (noise);
+  g_object_unref (smooth);
+
+  return result;
+}
+
+/* Transforms separated by a filter that is affine per channel are composed
+ * into one resampling when the sampler is linear in the pixel values. For
+ * a scale, brightness-contrast and rotation, the output has to be the
+ * filtered input sampled once through the product of both matrices, which
+ * noise tells apart from resampling twice. On smooth input it has to be
+ * close to rendering the scale and the filter first and rotating that.
+ */
+#define COMPOSE_SCALE  "matrix(0.8, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 1.0)"
+#define COMPOSE_ROTATE "matrix(0.866025, 0.5, 0.0, -0.5, 0.866025, 0.0, " \
+                       "-114.0, -514.0, 1.0)"
+#define COMPOSE_SIZE   64
+
+static GeglNode *
+scale_and_filter (GeglNode   *graph,
+                  GeglBuffer *source)
+{
+  GeglNode *input, *scale, *filter;
+
+  input = gegl_node_new_child (graph,
+                               "operation", "gegl:buffer-source",
+                               "buffer", source,
+                               NULL);
+  scale = gegl_node_new_child (graph,
+                               "operation", "gegl:transform",
+                               "transform", COMPOSE_SCALE,
+                               "sampler", GEGL_SAMPLER_LINEAR,
+                               NULL);
+  filter = gegl_node_new_child (graph,
+                                "operation", "gegl:brightness-contrast",
+                                "contrast", 1.5,
+                                "brightness", 0.1,
+                                NULL);
+  gegl_node_link_many (input, scale, filter, NULL);
+
+  return filter;
+}
+
+static void
+rotate (GeglNode *input,
+        gfloat   *output)
+{
+  GeglNode *graph    = gegl_node_get_parent (input);
+  GeglNode *rotation = gegl_node_new_child (graph,
+                                            "operation", "gegl:transform",
+                                            "transform", COMPOSE_ROTATE,
+                                            "sampler", GEGL_SAMPLER_LINEAR,
+                                            NULL);
+  gegl_node_link (input, rotation);
+
+  gegl_node_blit (rotation, 1.0,
+                  GEGL_RECTANGLE (0, 0, COMPOSE_SIZE, COMPOSE_SIZE),
+                  babl_format ("RGBA float"), output,
+                  GEGL_AUTO_ROWSTRIDE, GEGL_BLIT_DEFAULT);
+}
+
+static void
+render_composed (GeglBuffer *source,
+                 gfloat     *output)
+{
+  GeglNode *graph = gegl_node_new ();
+
+  rotate (scale_and_filter (graph, source), output);
+
+  g_object_unref (graph);
+}
+
+static void
+render_two_pass (GeglBuffer *source,
+                 gfloat     *output)
+{
+  GeglNode   *graph = gegl_node_new ();
+  GeglBuffer *filtered;
+
+  filtered = gegl_buffer_new (GEGL_RECTANGLE (0, 0, 820, 820),
+                              babl_format ("RGBA float"));
+  gegl_node_blit_buffer (scale_and_filter (graph, source), filtered,
+                         NULL, 0, GEGL_ABYSS_NONE);
+  g_object_unref (graph);
+
+  graph = gegl_node_new ();
+  rotate (gegl_node_new_child (graph,
+                               "operation", "gegl:buffer-source",
+                               "buffer", filtered,
+                               NULL),
+          output);
+  g_object_unref (graph);
+  g_object_unref (filtered);
+}
+
+static gboolean
+compare (const gchar  *what,
+         const gfloat *output,
+         const gfloat *expected,
+         gint          size,
+         gdouble       tolerance)
+{
+  gint i;
+
+  for (i = 0; i < size * size * 4; i++)
+    if (fabsf (output[i] - expected[i]) > tolerance)
+      {
+        g_printerr ("%s: pixel %d,%d channel %d is %f, expected %f\n",
+                    what, i / 4 % size, i / 4 / size, i % 4,
+                    output[i], expected[i]);
+        return FALSE;
+      }
+
+  return TRUE;
+}
+
+static gboolean
+test_composition (void)
+{
+  const Babl  *format   = babl_format ("RGBA float");
+  GeglBuffer  *noise    = noise_buffer (1024);
+  GeglBuffer  *smooth   = smooth_buffer ();
+  gfloat      *output   = g_new (gfloat, COMPOSE_SIZE * COMPOSE_SIZE * 4);
+  gfloat      *expected = g_new (gfloat, COMPOSE_SIZE * COMPOSE_SIZE * 4);
+  gboolean     result   = TRUE;
+  GeglMatrix3  scale, rotation, inverse;
+  gint         x, y, c;
+
+  gegl_matrix3_parse_string (&scale, COMPOSE_SCALE);
+  gegl_matrix3_parse_string (&rotation, COMPOSE_ROTATE);
+  gegl_matrix3_multiply (&rotation, &scale, &inverse);
+  gegl_matrix3_invert (&inverse);
+
+  for (y = 0; y < COMPOSE_SIZE; y++)
+    for (x = 0; x < COMPOSE_SIZE; x++)
+      {
+        gfloat  *pixel = expected + (y * COMPOSE_SIZE + x) * 4;
+        gdouble  u     = x + 0.5;
+        gdouble  v     = y + 0.5;
+
+        gegl_matrix3_transform_point (&inverse, &u, &v);
+        gegl_buffer_sample (noise, u, v, NULL, pixel, format,
+                            GEGL_SAMPLER_LINEAR, GEGL_ABYSS_NONE);
+
+        for (c = 0; c < 3; c++)
+          pixel[c] = (pixel[c] - 0.5) * 1.5 + 0.1 + 0.5;
+      }
+
+  render_composed (noise, output);
+
+  if (!compare ("composed", output, expected, COMPOSE_SIZE, 1e-4))
+    result = FALSE;
+
+  render_composed (smooth, output);
+  render_two_pass (smooth, expected);
+
+  if (!compare ("composed against two passes", output, expected,
+                COMPOSE_SIZE, 1e-3))
+    result = FALSE;
+
+  g_object_unref (noise);
+  g_object_unref (smooth);
+  g_free (output);
+  g_free (expected);
+
+  return result;
+}
+
+#undef COMPOSE_SCALE
+#undef COMPOSE_ROTATE
+#undef COMPOSE_SIZE
+
+/* Renders at mipmap level 1 keep the downsampled input in a cache of the
+ * operation. After the input changes, a render of the same node has to
+ * give what a fresh node gives for the changed input.
+ */
+#define CACHE_ROTATE "matrix(0.866025, 0.5, 0.0, -0.5, 0.866025, 0.0, " \
+                     "64.0, 0.0, 1.0)"
+#define CACHE_SIZE   128
+
+static void
+render_level (GeglNode *node,
+              gfloat   *output)
+{
+  GeglBuffer *buffer = gegl_buffer_new (GEGL_RECTANGLE (0, 0, CACHE_SIZE,
+                                                        CACHE_SIZE),
+                                        babl_format ("RaGaBaA float"));
+
+  gegl_node_blit_buffer (node, buffer, NULL, 1, GEGL_ABYSS_NONE);
+  gegl_buffer_get (buffer, GEGL_RECTANGLE (0, 0, CACHE_SIZE / 2,
+                                           CACHE_SIZE / 2),
+                   0.5, babl_format ("RaGaBaA float"), output,
+                   GEGL_AUTO_ROWSTRIDE, GEGL_ABYSS_NONE);
+  g_object_unref (buffer);
+}
+
+static GeglNode *
+cache_transform (GeglNode   *graph,
+                 GeglBuffer *source)
+{
+  GeglNode *input, *transform;
+
+  input = gegl_node_new_child (graph,
+                               "operation", "gegl:buffer-source",
+                               "buffer", source,
+                               NULL);
+  transform = gegl_node_new_child (graph,
+                                   "operation", "gegl:transform",
+                                   "transform", CACHE_ROTATE,
+                                   "sampler", GEGL_SAMPLER_LINEAR,
+                                   NULL);
+  gegl_node_link (input, transform);
+
+  return transform;
+}
+
+static gboolean
+test_source_cache (void)
+{
+  const Babl *format   = babl_format ("RaGaBaA float");
+  gint        n_floats = CACHE_SIZE / 2 * CACHE_SIZE / 2 * 4;
+  GeglBuffer *source   = noise_buffer (CACHE_SIZE);
+  gfloat     *before   = g_new (gfloat, n_floats);
+  gfloat     *after    = g_new (gfloat, n_floats);
+  gfloat     *expected = g_new (gfloat, n_floats);
+  gfloat     *white    = g_new (gfloat, 32 * 32 * 4);
+  gboolean    result   = TRUE;
+  GeglNode   *graph, *transform, *fresh;
+  gint        i;
+
+  graph     = gegl_node_new ();
+  transform = cache_transform (graph, source);
+  render_level (transform, before);
+
+  for (i = 0; i < 32 * 32 * 4; i++)
+    white[i] = 1.0;
+  gegl_buffer_set (source, GEGL_RECTANGLE (40, 40, 32, 32), 0, format, white,
+                   GEGL_AUTO_ROWSTRIDE);
+
+  render_level (transform, after);
+
+  fresh = gegl_node_new ();
+  render_level (cache_transform (fresh, source), expected);
+
+  if (!memcmp (before, expected, n_floats * sizeof (gfloat)))
+    {
+      g_printerr ("source cache: the change is not visible at level 1\n");
+      result = FALSE;
+    }
+  else if (!compare ("source cache", after, expected, CACHE_SIZE / 2, 1e-6))
+    {
+      result = FALSE;
+    }
+
+  g_object_unref (graph);
+  g_object_unref (fresh);
+  g_object_unref (source);
+  g_free (before);
+  g_free (after);
+  g_free (expected);
+  g_free (white);
+
+  return result;
+}
+
+#undef CACHE_ROTATE
+#undef CACHE_SIZE
+
+int main(int argc, char *argv[])
+{
+  int result = SUCCESS;
+
+  gegl_init (&argc, &argv);
+
+  if (!test_scale ())
+    result = FAILURE;
+  if (!test_perspective ())
+    result = FAILURE;
+  if (!test_downscale ())
+    result = FAILURE;
+  if (!test_composition ())
+    result = FAILURE;
+  if (!test_source_cache ())
+    result = FAILURE;
+
+  gegl_exit ();
+
+  return result;
+}